@@ -0,0 +1,306 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "../src/algorithms.hpp"
+#include "../src/grid.hpp"
+#include "../src/parallel.hpp"
+#include "../src/random.hpp"
+#include "../src/text_writer.hpp"
+
+/** The number of heap allocations made by the whole process so far. */
+static std::atomic<uint64_t> allocations(0);
+
+void* operator new(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* pointer = std::malloc(size ? size : 1)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+namespace {
+
+/**
+ * @brief A stream buffer that discards everything written to it.
+ */
+class NullBuffer : public std::streambuf {
+ protected:
+  int overflow(int c) override { return c; }
+  std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+/**
+ * @brief The measurements of one stage of one benchmark run.
+ */
+struct Measurement {
+  std::string algorithm;
+  int size;
+  std::string stage;
+  double seconds;
+  uint64_t allocations;
+  long peakKilobytes;
+};
+
+/**
+ * @brief Resets the peak resident set size of the process, so the next reading only covers what follows.
+ */
+void resetPeakMemory() {
+  std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+/**
+ * @brief Returns the peak resident set size of the process in kilobytes, or -1 if it is unknown.
+ */
+long peakMemory() {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, 6, "VmHWM:") == 0) {
+      return std::stol(line.substr(6));
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Runs one stage and records its time, allocations and peak memory.
+ */
+Measurement measure(const std::string& algorithm, int size, const std::string& stage,
+                    const std::function<void()>& body) {
+  resetPeakMemory();
+  uint64_t allocationsBefore = allocations.load();
+  auto start = std::chrono::steady_clock::now();
+  body();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return {algorithm, size, stage, elapsed.count(), allocations.load() - allocationsBefore, peakMemory()};
+}
+
+/**
+ * @brief Returns the side of the largest square grid the benchmark should try on this machine.
+ *
+ * The slowest generators keep about 16 bytes of state per cell next to the
+ * grid, so a sixty-fourth of the physical memory leaves plenty of headroom.
+ */
+int largestSize() {
+  uint64_t memory = uint64_t(sysconf(_SC_PHYS_PAGES)) * sysconf(_SC_PAGESIZE);
+  int size = 32;
+  while (uint64_t(2 * size) * (2 * size) * 64 <= memory && size < (1 << 15)) {
+    size *= 2;
+  }
+  return size;
+}
+
+void writeCsv(std::ostream& out, const std::vector<Measurement>& results) {
+  out << "algorithm,rows,columns,stage,seconds,cells_per_second,allocations_per_cell,peak_rss_kb\n";
+  for (const Measurement& result : results) {
+    double cells = double(result.size) * result.size;
+    out << result.algorithm << ',' << result.size << ',' << result.size << ',' << result.stage << ','
+        << result.seconds << ',' << (result.seconds > 0 ? cells / result.seconds : 0) << ','
+        << result.allocations / cells << ',' << result.peakKilobytes << '\n';
+  }
+}
+
+void writeJson(std::ostream& out, const std::vector<Measurement>& results) {
+  out << "[\n";
+  for (size_t i = 0; i < results.size(); i++) {
+    const Measurement& result = results[i];
+    double cells = double(result.size) * result.size;
+    out << "  {\"algorithm\": \"" << result.algorithm << "\", \"rows\": " << result.size
+        << ", \"columns\": " << result.size << ", \"stage\": \"" << result.stage
+        << "\", \"seconds\": " << result.seconds
+        << ", \"cells_per_second\": " << (result.seconds > 0 ? cells / result.seconds : 0)
+        << ", \"allocations_per_cell\": " << result.allocations / cells
+        << ", \"peak_rss_kb\": " << result.peakKilobytes << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  out << "]\n";
+}
+
+void printUsage(const char* program) {
+  std::cerr << "Usage: " << program << " [--format csv|json] [--output FILE] [--algorithms A,B,...]"
+            << " [--min-size N] [--max-size N] [--time-limit SECONDS] [--seed N] [--threads N]"
+            << " [--cell-size N] [--monochrome]" << std::endl;
+  std::cerr << "Sweeps every algorithm over square grids from --min-size (default 32) to --max-size"
+            << " (default: the largest that fits in memory), doubling the side each time." << std::endl;
+  std::cerr << "Larger sizes of an algorithm are skipped once one run takes longer than --time-limit"
+            << " (default 10 seconds)." << std::endl;
+}
+
+}  // namespace
+
+/**
+ * @brief Benchmarks construction, generation, text rendering and PNG encoding of every algorithm.
+ *
+ * Every stage is timed on its own, and reported with its throughput, the number
+ * of heap allocations per cell and the peak resident set size during the stage.
+ */
+int main(int argc, char** argv) {
+  std::string format = "csv";
+  std::string outputFilename;
+  std::vector<std::string> algorithms = algorithmNames();
+  int minSize = 32;
+  int maxSize = largestSize();
+  double timeLimit = 10;
+  uint64_t seed = 1;
+  int threads = 1;
+  int cellSize = 4;
+  bool monochrome = false;
+
+  try {
+    for (int i = 1; i < argc; i++) {
+      std::string argument = argv[i];
+      if (argument == "--format" && i + 1 < argc) {
+        format = argv[++i];
+      } else if (argument == "--output" && i + 1 < argc) {
+        outputFilename = argv[++i];
+      } else if (argument == "--algorithms" && i + 1 < argc) {
+        algorithms.clear();
+        std::stringstream list(argv[++i]);
+        for (std::string name; std::getline(list, name, ',');) {
+          algorithms.push_back(name);
+        }
+      } else if (argument == "--min-size" && i + 1 < argc) {
+        minSize = std::stoi(argv[++i]);
+      } else if (argument == "--max-size" && i + 1 < argc) {
+        maxSize = std::stoi(argv[++i]);
+      } else if (argument == "--time-limit" && i + 1 < argc) {
+        timeLimit = std::stod(argv[++i]);
+      } else if (argument == "--seed" && i + 1 < argc) {
+        seed = std::stoull(argv[++i]);
+      } else if (argument == "--threads" && i + 1 < argc) {
+        threads = std::stoi(argv[++i]);
+      } else if (argument == "--cell-size" && i + 1 < argc) {
+        cellSize = std::stoi(argv[++i]);
+      } else if (argument == "--monochrome") {
+        monochrome = true;
+      } else {
+        printUsage(argv[0]);
+        return 1;
+      }
+    }
+  } catch (std::exception& e) {
+    printUsage(argv[0]);
+    return 1;
+  }
+  if ((format != "csv" && format != "json") || minSize < 1) {
+    printUsage(argv[0]);
+    return 1;
+  }
+  for (const std::string& name : algorithms) {
+    if (!findAlgorithm(name)) {
+      std::cerr << "Unknown algorithm: " << name << std::endl;
+      return 1;
+    }
+  }
+
+  std::string imageFilename = "maze_benchmark_" + std::to_string(getpid()) + ".png";
+  NullBuffer discard;
+  std::ostream discardStream(&discard);
+  std::vector<Measurement> results;
+
+  for (const std::string& name : algorithms) {
+    Generator generator = findAlgorithm(name);
+    for (int size = minSize; size <= maxSize; size *= 2) {
+      std::cerr << name << " " << size << "x" << size << std::endl;
+      Random random(seed);
+      std::optional<Grid> grid;
+      results.push_back(measure(name, size, "construct", [&] { grid.emplace(size, size); }));
+      results.push_back(measure(name, size, "generate", [&] { generator(&*grid, random, threads); }));
+      double runSeconds = results.back().seconds;
+
+      results.push_back(measure(name, size, "ascii", [&] {
+        TextWriter writer(discardStream);
+        grid->writeRows(writer);
+        writer.finish();
+      }));
+
+      bool written = true;
+      results.push_back(measure(name, size, "png", [&] {
+        written = grid->generateImage(imageFilename, cellSize, 1, threads, monochrome);
+      }));
+      std::remove(imageFilename.c_str());
+      grid.reset();
+      if (!written) {
+        return 1;
+      }
+
+      if (runSeconds > timeLimit || size > maxSize / 2) {
+        break;
+      }
+    }
+  }
+
+  std::ofstream file;
+  if (!outputFilename.empty()) {
+    file.open(outputFilename);
+    if (!file) {
+      std::cerr << "Error opening file: " << outputFilename << std::endl;
+      return 1;
+    }
+  }
+  std::ostream& out = outputFilename.empty() ? std::cout : file;
+  if (format == "json") {
+    writeJson(out, results);
+  } else {
+    writeCsv(out, results);
+  }
+  return 0;
+}
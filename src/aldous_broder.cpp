@@ -24,19 +24,42 @@
 
 #include "aldous_broder.hpp"
 
-Grid AldousBroder::on(Grid *grid) {
-  srand((unsigned int)time(NULL));
-  Cell* cell = grid->getRandomCell();
+Stats AldousBroder::on(Grid *grid, Random& random, double handoff) {
+  Stats stats;
+  Bitset visited(grid->size());
+  STATS_ALLOCATION(stats, visited.bytes());
+  int columns = grid->getColumns();
+  int index = random.below(grid->size());
+  int row = index / columns;
+  int column = index % columns;
+  visited.set(index);
+
   int unvisited = grid->size() - 1;
+  int target = static_cast<int>(handoff * grid->size());
 
-  while (unvisited > 0) {
-    Cell* neighbor = cell->getNeighbors().at(rand() % cell->getNeighbors().size());
-    if (neighbor->getLinks().empty()) {
-      cell->link(neighbor);
-      unvisited--;
+  {
+    STATS_PHASE(stats, "walk");
+    while (unvisited > 0 && unvisited >= target) {
+      Grid::Direction direction = grid->randomDirection(row, column, random);
+      int neighbor = index + grid->offset(direction);
+      STATS_COUNT(stats, steps, 1);
+      if (!visited.test(neighbor)) {
+        visited.set(neighbor);
+        grid->link(index, neighbor);
+        STATS_COUNT(stats, links, 1);
+        unvisited--;
+      } else {
+        STATS_COUNT(stats, revisits, 1);
+      }
+      row += Grid::ROW_STEP[direction];
+      column += Grid::COLUMN_STEP[direction];
+      index = neighbor;
     }
-    cell = neighbor;
   }
 
-  return *grid;
-}
\ No newline at end of file
+  if (unvisited > 0) {
+    stats.merge(Wilsons::complete(grid, visited, random));
+  }
+
+  return stats;
+}
@@ -28,7 +28,11 @@
 #include <vector>
 #include <algorithm>
 
+#include "bitset.hpp"
 #include "grid.hpp"
+#include "random.hpp"
+#include "stats.hpp"
+#include "wilsons.hpp"
 
 /**
  * @class AldousBroder
@@ -42,20 +46,31 @@
  * all cells have been visited.
  *
  * The AldousBroder class provides a static method `on` that takes a Grid object as input
- * and generates a maze using the Aldous-Broder algorithm. The generated maze is returned
- * as a Grid object.
+ * and generates a maze using the Aldous-Broder algorithm in place.
  */
 class AldousBroder {
  public:
     /**
     * Generates a maze using the Aldous-Broder algorithm on the given grid.
     *
+    * The walk keeps the visited cells in a bitset and picks neighbors from the
+    * grid's neighbor mask tables, so no memory is allocated per step. Aldous-Broder
+    * spends most of its time in a long tail looking for the last few unvisited
+    * cells. With a non-zero `handoff`, the walk stops once the fraction of unvisited
+    * cells drops below it and Wilson's loop-erased walks finish the maze; both
+    * phases preserve the uniform spanning tree distribution.
+    *
     * @param grid The grid on which the maze is generated.
-    * @return The grid with the generated maze.
+    * @param random The random number generator to draw from.
+    * @param handoff The unvisited fraction (0 to 1) at which to hand off to Wilson's algorithm. 0 disables the hand-off.
+    * @return The counters collected while generating the maze.
     */
-    static Grid on(Grid *grid);
- //private:
-    //Cell unvisited_cells;
+    static Stats on(Grid *grid, Random& random, double handoff = 0.0);
+
+    /**
+     * The hand-off fraction used by the hybrid `AldousBroderWilsons` algorithm.
+     */
+    static constexpr double HYBRID_HANDOFF = 0.5;
   };
 
 #endif // ALDOUS_BRODER_HPP
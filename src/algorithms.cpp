@@ -0,0 +1,119 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "algorithms.hpp"
+
+#include <utility>
+
+#include "aldous_broder.hpp"
+#include "binary_tree.cpp"
+#include "ellers.hpp"
+#include "growing_tree.hpp"
+#include "hunt_and_kill.hpp"
+#include "kruskals.hpp"
+#include "prims.hpp"
+#include "recursive_backtracker.hpp"
+#include "sidewinder.hpp"
+#include "wilsons.hpp"
+
+namespace {
+
+const std::vector<std::pair<std::string, Generator>>& algorithms() {
+  static const std::vector<std::pair<std::string, Generator>> table = {
+    {"BinaryTree", [](Grid* grid, Random& random, int threads) {
+      return BinaryTree::on(grid, random, threads);
+    }},
+    {"Sidewinder", [](Grid* grid, Random& random, int threads) {
+      return Sidewinder::on(grid, random, threads);
+    }},
+    {"Ellers", [](Grid* grid, Random& random, int) {
+      return Ellers::on(grid, random);
+    }},
+    {"AldousBroder", [](Grid* grid, Random& random, int) {
+      return AldousBroder::on(grid, random);
+    }},
+    {"AldousBroderWilsons", [](Grid* grid, Random& random, int) {
+      return AldousBroder::on(grid, random, AldousBroder::HYBRID_HANDOFF);
+    }},
+    {"Wilsons", [](Grid* grid, Random& random, int) {
+      return Wilsons::on(grid, random);
+    }},
+    {"Kruskals", [](Grid* grid, Random& random, int) {
+      return Kruskals::on(grid, random);
+    }},
+    {"RecursiveBacktracker", [](Grid* grid, Random& random, int) {
+      return RecursiveBacktracker::on(grid, random);
+    }},
+    {"HuntAndKill", [](Grid* grid, Random& random, int) {
+      return HuntAndKill::on(grid, random);
+    }},
+    {"GrowingTree", [](Grid* grid, Random& random, int) {
+      return GrowingTree<Selection::Mixed<50>>::on(grid, random);
+    }},
+    {"SimplifiedPrims", [](Grid* grid, Random& random, int) {
+      return GrowingTree<Selection::Random>::on(grid, random);
+    }},
+    {"Prims", [](Grid* grid, Random& random, int) {
+      return Prims::on(grid, random);
+    }},
+  };
+  return table;
+}
+
+const std::vector<std::pair<std::string, Streamer>>& streamingAlgorithms() {
+  static const std::vector<std::pair<std::string, Streamer>> table = {
+    {"BinaryTree", BinaryTree::stream},
+    {"Sidewinder", Sidewinder::stream},
+    {"Ellers", Ellers::stream},
+  };
+  return table;
+}
+
+}  // namespace
+
+Generator findAlgorithm(const std::string& name) {
+  for (const auto& algorithm : algorithms()) {
+    if (algorithm.first == name) {
+      return algorithm.second;
+    }
+  }
+  return Generator();
+}
+
+Streamer findStreamingAlgorithm(const std::string& name) {
+  for (const auto& algorithm : streamingAlgorithms()) {
+    if (algorithm.first == name) {
+      return algorithm.second;
+    }
+  }
+  return Streamer();
+}
+
+std::vector<std::string> algorithmNames() {
+  std::vector<std::string> names;
+  for (const auto& algorithm : algorithms()) {
+    names.push_back(algorithm.first);
+  }
+  return names;
+}
@@ -0,0 +1,73 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ALGORITHMS_HPP
+#define ALGORITHMS_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "grid.hpp"
+#include "random.hpp"
+#include "row_sink.hpp"
+#include "stats.hpp"
+
+/**
+ * @brief A maze generation algorithm that carves a perfect maze into a grid.
+ *
+ * The thread count is a hint; algorithms that cannot use several threads ignore it.
+ * Returns the counters collected while generating, see Stats.
+ */
+using Generator = std::function<Stats(Grid* grid, Random& random, int threads)>;
+
+/**
+ * @brief Looks up a maze generation algorithm by the name used on the command line.
+ * @param name The name of the algorithm, e.g. "Wilsons".
+ * @return The algorithm, or an empty function if the name is unknown.
+ */
+Generator findAlgorithm(const std::string& name);
+
+/**
+ * @brief A maze generation algorithm that writes a maze to a sink row by row.
+ *
+ * Streaming algorithms only keep a few rows in memory, so the number of rows is
+ * not limited by memory or by the range of an int.
+ */
+using Streamer = std::function<Stats(int64_t rows, int columns, Random& random, RowSink& sink)>;
+
+/**
+ * @brief Looks up a streaming maze generation algorithm by name.
+ * @param name The name of the algorithm, e.g. "Ellers".
+ * @return The algorithm, or an empty function if the name is unknown or the algorithm cannot stream.
+ */
+Streamer findStreamingAlgorithm(const std::string& name);
+
+/**
+ * @brief Returns the names of all algorithms known to findAlgorithm().
+ */
+std::vector<std::string> algorithmNames();
+
+#endif  // ALGORITHMS_HPP
@@ -0,0 +1,140 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "batch.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <sstream>
+
+#include "algorithms.hpp"
+#include "grid.hpp"
+#include "parallel.hpp"
+#include "random.hpp"
+#include "text_writer.hpp"
+
+namespace {
+
+bool endsWith(const std::string& text, const std::string& suffix) {
+  return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/**
+ * @brief Writes a maze to the output of its job, in the format given by the file extension.
+ */
+bool write(const Grid& grid, const BatchJob& job, int cellSize, int wallSize, bool monochrome) {
+  if (endsWith(job.output, ".png")) {
+    return grid.generateImage(job.output, cellSize, wallSize, 1, monochrome);
+  }
+  if (endsWith(job.output, ".maze")) {
+    return grid.save(job.output, job.algorithm, job.seed);
+  }
+  std::ofstream out(job.output);
+  if (!out) {
+    std::cerr << "Error opening file: " << job.output << std::endl;
+    return false;
+  }
+  TextWriter writer(out);
+  grid.writeRows(writer);
+  if (!writer.finish()) {
+    std::cerr << "Error writing file: " << job.output << std::endl;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool Batch::readManifest(std::istream& in, std::vector<BatchJob>& jobs) {
+  bool valid = true;
+  std::string line;
+  for (int number = 1; std::getline(in, line); number++) {
+    std::istringstream fields(line);
+    std::string first;
+    if (!(fields >> first) || first[0] == '#') {
+      continue;
+    }
+
+    BatchJob job;
+    long long rows = 0, columns = 0;
+    std::string rest;
+    job.algorithm = first;
+    if (!(fields >> rows >> columns >> job.seed >> job.output) || (fields >> rest)) {
+      std::cerr << "Line " << number << ": expected algorithm rows columns seed output" << std::endl;
+      valid = false;
+    } else if (!findAlgorithm(job.algorithm)) {
+      std::cerr << "Line " << number << ": unknown algorithm " << job.algorithm << std::endl;
+      valid = false;
+    } else if (rows <= 0 || columns <= 0 || rows > std::numeric_limits<int>::max() / columns) {
+      std::cerr << "Line " << number << ": the maze must have a positive number of rows and columns"
+                << " and its cell count must fit in an int" << std::endl;
+      valid = false;
+    } else {
+      job.rows = rows;
+      job.columns = columns;
+      jobs.push_back(job);
+    }
+  }
+  return valid;
+}
+
+bool Batch::readManifest(const std::string& filename, std::vector<BatchJob>& jobs) {
+  std::ifstream in(filename);
+  if (!in) {
+    std::cerr << "Error opening file: " << filename << std::endl;
+    return false;
+  }
+  return readManifest(in, jobs);
+}
+
+int Batch::run(const std::vector<BatchJob>& jobs, int threads, int cellSize, int wallSize, bool monochrome) {
+  // Every worker reuses one grid for all of its jobs
+  std::vector<std::optional<Grid>> grids(std::max(1, threads));
+  std::vector<int> failures(grids.size(), 0);
+
+  parallelFor(jobs.size(), threads, [&](int item, int worker) {
+    const BatchJob& job = jobs[item];
+    std::optional<Grid>& grid = grids[worker];
+    if (grid) {
+      grid->reset(job.rows, job.columns);
+    } else {
+      grid.emplace(job.rows, job.columns);
+    }
+
+    Random random(job.seed);
+    findAlgorithm(job.algorithm)(&*grid, random, 1);
+    if (!write(*grid, job, cellSize, wallSize, monochrome)) {
+      failures[worker]++;
+    }
+  });
+
+  int failed = 0;
+  for (int count : failures) {
+    failed += count;
+  }
+  return failed;
+}
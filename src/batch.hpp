@@ -0,0 +1,89 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One maze of a batch: how to generate it and where to write it.
+ */
+struct BatchJob {
+  std::string algorithm; /**< The name of the algorithm, as accepted by findAlgorithm(). */
+  int rows = 0; /**< The number of rows of the maze. */
+  int columns = 0; /**< The number of columns of the maze. */
+  uint64_t seed = 0; /**< The seed of the maze. */
+  std::string output; /**< The output file; .png is an image, .maze a binary maze file, anything else text. */
+};
+
+/**
+ * @class Batch
+ * @brief Generates many mazes in one process on a pool of worker threads.
+ *
+ * Jobs are handed out to the workers one at a time, so mazes of different sizes
+ * balance out. Every worker keeps a single Grid and resets it for each of its
+ * jobs, which reuses the cell storage of the largest maze it has generated so
+ * far instead of allocating a new grid per maze. Each maze is generated on a
+ * single thread and only depends on its own seed, so the output does not depend
+ * on the number of workers or the order of the jobs.
+ */
+class Batch {
+ public:
+  /**
+   * @brief Reads the jobs of a manifest.
+   *
+   * Every line holds one job as `algorithm rows columns seed output`, separated
+   * by whitespace. Empty lines and lines starting with `#` are skipped. Errors are
+   * reported on std::cerr with their line number.
+   * @param in The manifest.
+   * @param jobs The vector receiving the jobs.
+   * @return True if every line was valid, false otherwise.
+   */
+  static bool readManifest(std::istream& in, std::vector<BatchJob>& jobs);
+
+  /**
+   * @brief Reads the jobs of a manifest file.
+   * @see readManifest(std::istream&, std::vector<BatchJob>&)
+   */
+  static bool readManifest(const std::string& filename, std::vector<BatchJob>& jobs);
+
+  /**
+   * @brief Generates and writes the mazes of all jobs.
+   *
+   * A job that cannot be written is reported on std::cerr and does not stop the others.
+   * @param jobs The jobs, whose algorithms must be known.
+   * @param threads The number of workers.
+   * @param cellSize The size of each cell in pixels, for image outputs.
+   * @param wallSize The thickness of each wall in pixels, for image outputs.
+   * @param monochrome Whether images are written as 1-bit grayscale instead of RGB.
+   * @return The number of jobs that failed.
+   */
+  static int run(const std::vector<BatchJob>& jobs, int threads, int cellSize, int wallSize, bool monochrome);
+};
+
+#endif  // BATCH_HPP
@@ -22,21 +22,30 @@
  * SOFTWARE.
  */
 
-#include <vector>
-#include <cstdlib>  // For rand()
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
-#include <ctime>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include "grid.hpp"
+#include "random.hpp"
+#include "row_sink.hpp"
+#include "stats.hpp"
 
 /**
  * @class BinaryTree
  * @brief Represents a binary tree maze generation algorithm.
  *
  * The BinaryTree class provides a static method `on` that generates a binary tree maze
- * on a given grid. The algorithm randomly selects either the north or east neighbor of
+ * on a given grid in place. The algorithm randomly selects either the north or east neighbor of
  * each cell and links it to the current cell. This results in a maze with a bias towards
  * passages that go north or east.
+ *
+ * Every row draws from its own random stream, so rows are independent of each other
+ * and can be generated on several threads. The maze only depends on the seed, not on
+ * the number of threads.
  */
 class BinaryTree {
  public:
@@ -44,25 +53,101 @@ class BinaryTree {
    * Generates a binary tree maze on the given grid.
    *
    * @param grid The grid on which the maze is generated.
-   * @return The grid with the generated maze.
+   * @param random The random number generator to draw from.
+   * @param threads The number of threads to use.
+   * @return The counters collected while generating the maze.
+   */
+  static Stats on(Grid* grid, Random& random, int threads = 1) {
+    Stats stats;
+    uint64_t seed = random.next();
+    int columns = grid->getColumns();
+
+    {
+      STATS_PHASE(stats, "rows");
+      std::mutex statsMutex;
+      grid->eachRowInParallel(threads, [&](int row) {
+        uint8_t* current = grid->data() + grid->index(row, 0);
+        Stats rowStats;
+        carveRow(seed, row, current, row > 0 ? current - columns : nullptr, columns, rowStats);
+        if (Stats::ENABLED) {
+          std::lock_guard<std::mutex> lock(statsMutex);
+          stats.merge(rowStats);
+        }
+      });
+    }
+    return stats;
+  }
+
+  /**
+   * Generates a binary tree maze and writes it to a sink row by row.
+   *
+   * A row is passed on once the row below it has carved its north passages, so
+   * only two rows are kept in memory. The maze is the same as the one `on`
+   * generates from the same seed.
+   *
+   * @param rows The number of rows of the maze.
+   * @param columns The number of columns of the maze.
+   * @param random The random number generator to draw from.
+   * @param sink The sink receiving each finished row.
+   * @return The counters collected while generating the maze.
    */
-  static Grid on(Grid grid) {
-    srand((unsigned int)time(NULL));
-    grid.eachCell([](Cell* cell) {
-      std::vector<Cell*> neighbors;
-      if (cell->north_ != nullptr) {
-        neighbors.push_back(cell->north_);
+  static Stats stream(int64_t rows, int columns, Random& random, RowSink& sink) {
+    Stats stats;
+    uint64_t seed = random.next();
+    std::vector<uint8_t> above(columns), current(columns);
+    STATS_ALLOCATION(stats, above.size());
+    STATS_ALLOCATION(stats, current.size());
+
+    for (int64_t row = 0; row < rows; row++) {
+      std::fill(current.begin(), current.end(), 0);
+      carveRow(seed, row, current.data(), row > 0 ? above.data() : nullptr, columns, stats);
+      if (row > 0) {
+        sink.writeRow(above.data(), columns);
       }
-      if (cell->east_ != nullptr) {
-        neighbors.push_back(cell->east_);
+      std::swap(above, current);
+    }
+    if (rows > 0) {
+      sink.writeRow(above.data(), columns);
+    }
+    return stats;
+  }
+
+ private:
+  /**
+   * Carves the passages of a single row.
+   *
+   * @param seed The seed of the maze; every row draws from its own stream of it.
+   * @param row The index of the row.
+   * @param current The passage bits of the row, which receive its east passages.
+   * @param above The passage bits of the row above, which receive the north passages, or nullptr for the first row.
+   * @param columns The number of columns.
+   * @param stats The stats counting the passages carved.
+   */
+  static void carveRow(uint64_t seed, int64_t row, uint8_t* current, uint8_t* above, int columns,
+                       [[maybe_unused]] Stats& stats) {
+    Random rowRandom(seed, row);
+    uint64_t bits = 0;
+
+    for (int column = 0; column < columns; column++) {
+      bool hasNorth = above != nullptr;
+      bool hasEast = column < columns - 1;
+
+      // Take one random bit per cell that has to choose
+      if (hasNorth && hasEast) {
+        if ((column & 63) == 0) {
+          bits = rowRandom.next();
+        }
+        hasNorth = (bits >> (column & 63)) & 1;
+        hasEast = !hasNorth;
       }
 
-      if (!neighbors.empty()) {
-        int index = rand() % neighbors.size();
-        Cell* neighbor = neighbors[index];
-        cell->link(neighbor);
+      if (hasNorth) {
+        above[column] |= Grid::LINK_SOUTH;
+        STATS_COUNT(stats, links, 1);
+      } else if (hasEast) {
+        current[column] |= Grid::LINK_EAST;
+        STATS_COUNT(stats, links, 1);
       }
-    });
-    return grid;
+    }
   }
 };
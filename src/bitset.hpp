@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BITSET_HPP
+#define BITSET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class Bitset
+ * @brief A dynamically sized, word-packed set of bits.
+ *
+ * Used by the generators to track visited cells with one bit per cell. Unlike
+ * std::vector<bool> it exposes word-level scans, so finding the next cleared bit
+ * skips 64 cells at a time.
+ */
+class Bitset {
+ private:
+  std::vector<uint64_t> words_; /**< The packed bits, least significant bit first. */
+  size_t size_; /**< The number of addressable bits. */
+
+ public:
+  /**
+   * @brief Constructs a bitset with all bits cleared.
+   * @param size The number of bits.
+   */
+  explicit Bitset(size_t size = 0) : words_((size + 63) / 64, 0), size_(size) {}
+
+  /**
+   * @brief Returns the number of bits in the set.
+   */
+  size_t size() const { return size_; }
+
+  /**
+   * @brief Returns the number of bytes used to store the bits.
+   */
+  size_t bytes() const { return words_.size() * sizeof(uint64_t); }
+
+  bool test(size_t i) const { return (words_[i >> 6] >> (i & 63)) & 1; }
+
+  void set(size_t i) { words_[i >> 6] |= uint64_t(1) << (i & 63); }
+
+  void reset(size_t i) { words_[i >> 6] &= ~(uint64_t(1) << (i & 63)); }
+
+  /**
+   * @brief Returns the index of the first cleared bit at or after `from`, or size() if there is none.
+   */
+  size_t findNextZero(size_t from) const {
+    if (from >= size_) {
+      return size_;
+    }
+    size_t word = from >> 6;
+    uint64_t bits = ~words_[word] & (~uint64_t(0) << (from & 63));
+    while (bits == 0) {
+      if (++word == words_.size()) {
+        return size_;
+      }
+      bits = ~words_[word];
+    }
+    size_t index = (word << 6) + __builtin_ctzll(bits);
+    return index < size_ ? index : size_;
+  }
+
+  /**
+   * @brief Returns the index of the first set bit at or after `from`, or size() if there is none.
+   */
+  size_t findNextOne(size_t from) const {
+    if (from >= size_) {
+      return size_;
+    }
+    size_t word = from >> 6;
+    uint64_t bits = words_[word] & (~uint64_t(0) << (from & 63));
+    while (bits == 0) {
+      if (++word == words_.size()) {
+        return size_;
+      }
+      bits = words_[word];
+    }
+    return (word << 6) + __builtin_ctzll(bits);
+  }
+};
+
+#endif  // BITSET_HPP
@@ -23,49 +23,67 @@
  */
 
 #include "cell.hpp"
+#include "grid.hpp"
 
-Cell::Cell(int row, int column) : row_(row), column_(column),
-                                north_(nullptr), south_(nullptr),
-                                east_(nullptr), west_(nullptr) {}
+Cell::Cell() : grid_(nullptr), row_(-1), column_(-1) {}
 
-Cell::~Cell() {
-  delete north_;
-  delete south_;
-  delete east_;
-  delete west_;
+Cell::Cell(Grid* grid, int row, int column) : grid_(grid), row_(row), column_(column) {}
+
+int Cell::index() const {
+  return grid_->index(row_, column_);
 }
 
-void Cell::link(Cell* cell, bool bidi) {
-  links_[cell] = true;
-  if (bidi) {
-    cell->link(this, false);
-  }
+Cell Cell::north() const {
+  return grid_ ? grid_->getCell(row_ - 1, column_) : Cell();
 }
 
-void Cell::unlink(Cell* cell, bool bidi) {
-  links_[cell] = false;
-  if (bidi) {
-    cell->unlink(this, false);
-  }
+Cell Cell::south() const {
+  return grid_ ? grid_->getCell(row_ + 1, column_) : Cell();
+}
+
+Cell Cell::east() const {
+  return grid_ ? grid_->getCell(row_, column_ + 1) : Cell();
+}
+
+Cell Cell::west() const {
+  return grid_ ? grid_->getCell(row_, column_ - 1) : Cell();
 }
 
-std::vector<Cell*> Cell::getLinks() {
-  std::vector<Cell*> linkedCells;
-  for (auto& link : links_) {
-    linkedCells.push_back(link.first);
+void Cell::link(const Cell& cell) {
+  grid_->link(index(), cell.index());
+}
+
+void Cell::unlink(const Cell& cell) {
+  grid_->unlink(index(), cell.index());
+}
+
+std::vector<Cell> Cell::getLinks() const {
+  std::vector<Cell> linkedCells;
+  for (const Cell& neighbor : getNeighbors()) {
+    if (isLinked(neighbor)) {
+      linkedCells.push_back(neighbor);
+    }
   }
   return linkedCells;
 }
 
-bool Cell::isLinked(Cell* cell) {
-  return links_.count(cell) > 0;
+bool Cell::isLinked(const Cell& cell) const {
+  if (!grid_ || !cell || cell.grid_ != grid_) {
+    return false;
+  }
+  int rowDistance = std::abs(cell.row_ - row_);
+  int columnDistance = std::abs(cell.column_ - column_);
+  if (rowDistance + columnDistance != 1) {
+    return false;
+  }
+  return grid_->isLinked(index(), cell.index());
 }
 
-std::vector<Cell*> Cell::getNeighbors() {
-  std::vector<Cell*> neighbors;
-  if (north_) neighbors.push_back(north_);
-  if (south_) neighbors.push_back(south_);
-  if (east_)  neighbors.push_back(east_);
-  if (west_)  neighbors.push_back(west_);
+std::vector<Cell> Cell::getNeighbors() const {
+  std::vector<Cell> neighbors;
+  if (Cell cell = north()) neighbors.push_back(cell);
+  if (Cell cell = south()) neighbors.push_back(cell);
+  if (Cell cell = east())  neighbors.push_back(cell);
+  if (Cell cell = west())  neighbors.push_back(cell);
   return neighbors;
 }
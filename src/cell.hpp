@@ -25,69 +25,118 @@
 #ifndef SRC_CELL_HPP
 #define SRC_CELL_HPP
 
-#include <unordered_map>
 #include <vector>
 
+class Grid;
+
 /**
  * @class Cell
  * @brief Represents a cell in a maze grid.
+ *
+ * A Cell is a thin view onto one position of a Grid. It does not own any state:
+ * passages live in the grid's flat storage and neighbors are computed from the
+ * cell's position, so cells can be created and copied freely. A default
+ * constructed Cell refers to no position and evaluates to false, which is how
+ * missing neighbors at the grid boundary are represented.
  */
 class Cell {
  private:
+   Grid* grid_; /**< The grid this cell belongs to, or nullptr for a null cell. */
    int row_; /**< The row index of the cell in the grid. */
    int column_; /**< The column index of the cell in the grid. */
-   std::unordered_map<Cell*, bool> links_; /**< A map of linked cells and their link status. */
 
  public:
-   Cell* north_; /**< Pointer to the cell to the north of this cell. */
-   Cell* south_; /**< Pointer to the cell to the south of this cell. */
-   Cell* east_; /**< Pointer to the cell to the east of this cell. */
-   Cell* west_; /**< Pointer to the cell to the west of this cell. */
+   /**
+    * @brief Constructs a null Cell that refers to no grid position.
+    */
+   Cell();
 
    /**
-    * @brief Constructs a new Cell object.
+    * @brief Constructs a view of a cell in a grid.
+    * @param grid The grid the cell belongs to.
     * @param row The row index of the cell in the grid.
     * @param column The column index of the cell in the grid.
     */
-   Cell(int row, int column);
+   Cell(Grid* grid, int row, int column);
+
+   /**
+    * @brief Returns the row index of the cell.
+    */
+   int row() const { return row_; }
+
+   /**
+    * @brief Returns the column index of the cell.
+    */
+   int column() const { return column_; }
+
+   /**
+    * @brief Returns the row-major index of the cell in its grid.
+    */
+   int index() const;
+
+   /**
+    * @brief Checks whether this cell refers to a grid position.
+    */
+   explicit operator bool() const { return grid_ != nullptr; }
+
+   bool operator==(const Cell& other) const {
+     return grid_ == other.grid_ && row_ == other.row_ && column_ == other.column_;
+   }
+
+   bool operator!=(const Cell& other) const { return !(*this == other); }
+
+   /**
+    * @brief Returns the cell to the north of this cell, or a null cell at the boundary.
+    */
+   Cell north() const;
+
+   /**
+    * @brief Returns the cell to the south of this cell, or a null cell at the boundary.
+    */
+   Cell south() const;
+
+   /**
+    * @brief Returns the cell to the east of this cell, or a null cell at the boundary.
+    */
+   Cell east() const;
 
    /**
-    * @brief Destroys the Cell object.
+    * @brief Returns the cell to the west of this cell, or a null cell at the boundary.
     */
-   ~Cell();
+   Cell west() const;
 
    /**
-    * @brief Links this cell to another cell.
-    * @param cell The cell to be linked.
-    * @param bidi Flag indicating whether the link should be bidirectional (default: true).
+    * @brief Carves a passage between this cell and a neighboring cell.
+    *
+    * Passages are stored once per pair of cells, so links are always bidirectional.
+    * @param cell The neighboring cell to be linked.
     */
-   void link(Cell* cell, bool bidi = true);
+   void link(const Cell& cell);
 
    /**
-    * @brief Unlinks this cell from another cell.
-    * @param cell The cell to be unlinked.
-    * @param bidi Flag indicating whether the unlink should be bidirectional (default: true).
+    * @brief Removes the passage between this cell and a neighboring cell.
+    * @param cell The neighboring cell to be unlinked.
     */
-   void unlink(Cell* cell, bool bidi = true);
+   void unlink(const Cell& cell);
 
    /**
     * @brief Returns a vector of cells that are linked to this cell.
     * @return A vector of linked cells.
     */
-   std::vector<Cell*> getLinks();
+   std::vector<Cell> getLinks() const;
 
    /**
     * @brief Checks if this cell is linked to another cell.
-    * @param cell The cell to check for a link.
+    * @param cell The cell to check for a link. Null and non-adjacent cells are never linked.
     * @return True if the cells are linked, false otherwise.
     */
-   bool isLinked(Cell* cell);
+   bool isLinked(const Cell& cell) const;
 
    /**
     * @brief Returns a vector of neighboring cells of this cell.
     * @return A vector of neighboring cells.
     */
-   std::vector<Cell*> getNeighbors();
+   std::vector<Cell> getNeighbors() const;
 };
 
 #endif  // SRC_CELL_HPP
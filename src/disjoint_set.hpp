@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DISJOINT_SET_HPP
+#define DISJOINT_SET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @class DisjointSet
+ * @brief A union-find structure over the integers 0 to size - 1.
+ *
+ * The whole structure is one flat array of ints indexed by element: a
+ * non-negative entry is the parent of the element, and a root stores the
+ * negated rank of its tree minus one instead. Keeping the rank in the root's own
+ * slot means a union touches no memory besides the two paths it follows.
+ * Finding a root halves the path on the way (every other element visited is
+ * pointed at its grandparent), and uniting two sets hangs the root of lower rank
+ * below the other. Together they make any sequence of operations run in
+ * practically constant amortized time per operation.
+ */
+class DisjointSet {
+ private:
+  std::vector<int32_t> parent_; /**< The parent of each element, or -1 - rank for roots. */
+
+ public:
+  /**
+   * @brief Constructs the structure with every element in a set of its own.
+   * @param size The number of elements.
+   */
+  explicit DisjointSet(size_t size = 0) : parent_(size, -1) {}
+
+  /**
+   * @brief Returns the number of elements.
+   */
+  size_t size() const { return parent_.size(); }
+
+  /**
+   * @brief Returns the number of bytes used by the structure.
+   */
+  size_t bytes() const { return parent_.size() * sizeof(int32_t); }
+
+  /**
+   * @brief Returns the root of the set containing an element, halving the path to it.
+   */
+  int32_t find(int32_t element) {
+    while (parent_[element] >= 0) {
+      int32_t parent = parent_[element];
+      int32_t grandparent = parent_[parent];
+      if (grandparent < 0) {
+        return parent;
+      }
+      parent_[element] = grandparent;
+      element = grandparent;
+    }
+    return element;
+  }
+
+  /**
+   * @brief Merges the sets containing two elements.
+   * @return True if the elements were in different sets, false if nothing changed.
+   */
+  bool unite(int32_t a, int32_t b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) {
+      return false;
+    }
+    // Ranks are stored negated, so the larger entry has the lower rank
+    if (parent_[a] > parent_[b]) {
+      std::swap(a, b);
+    }
+    if (parent_[a] == parent_[b]) {
+      parent_[a]--;
+    }
+    parent_[b] = a;
+    return true;
+  }
+
+  /**
+   * @brief Hints the processor to load the entry of an element, ahead of a find().
+   */
+  void prefetch(int32_t element) const { __builtin_prefetch(&parent_[element]); }
+};
+
+#endif  // DISJOINT_SET_HPP
@@ -0,0 +1,178 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "distance_oracle.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+DistanceOracle::DistanceOracle(const Grid& grid) {
+  auto start = std::chrono::steady_clock::now();
+  const int size = grid.size();
+
+  // A spanning tree has exactly one passage fewer than cells
+  int64_t passages = 0;
+  for (int cell = 0; cell < size; cell++) {
+    uint8_t links = grid.passages(cell);
+    passages += (links & Grid::LINK_EAST) + ((links & Grid::LINK_SOUTH) >> 1);
+  }
+  if (passages != size - 1) {
+    throw std::invalid_argument("DistanceOracle needs a perfect maze");
+  }
+
+  // Number the cells in depth-first preorder. Every stack entry carries the
+  // preorder number of the cell it was pushed from.
+  preorder_.assign(size, -1);
+  cell_.resize(size);
+  depth_.resize(size);
+  parent_.resize(size);
+  std::vector<std::pair<int32_t, int32_t>> stack = {{0, 0}};
+  int32_t count = 0;
+  while (!stack.empty()) {
+    auto [cell, parent] = stack.back();
+    stack.pop_back();
+    if (preorder_[cell] >= 0) {
+      continue;
+    }
+    int32_t node = count++;
+    preorder_[cell] = node;
+    cell_[node] = cell;
+    parent_[node] = parent;
+    depth_[node] = node == 0 ? 0 : depth_[parent] + 1;
+    grid.eachLink(cell, [&](int neighbor) {
+      if (preorder_[neighbor] < 0) {
+        stack.emplace_back(neighbor, node);
+      }
+    });
+  }
+  if (count != size) {
+    throw std::invalid_argument("DistanceOracle needs a perfect maze");
+  }
+
+  // Skew-binary jump pointers: a node jumps twice as far as its parent if the
+  // parent's jump and the jump after it have the same length
+  jump_.resize(size);
+  jump_[0] = 0;
+  for (int32_t node = 1; node < size; node++) {
+    int32_t parent = parent_[node];
+    int32_t jump = jump_[parent];
+    bool equal = depth_[parent] - depth_[jump] == depth_[jump] - depth_[jump_[jump]];
+    jump_[node] = equal ? jump_[jump] : parent;
+  }
+
+  // Bit masks of the suffix minima within each block, and the minimum of every block
+  blocks_ = (size + BLOCK - 1) / BLOCK;
+  mask_.resize(size);
+  table_.resize(blocks_);
+  for (int block = 0; block < blocks_; block++) {
+    int first = block * BLOCK;
+    int last = std::min(size, first + BLOCK);
+    uint32_t mask = 0;
+    for (int position = first; position < last; position++) {
+      while (mask != 0 && parent_[first + 31 - __builtin_clz(mask)] >= parent_[position]) {
+        mask &= ~(uint32_t(1) << (31 - __builtin_clz(mask)));
+      }
+      mask |= uint32_t(1) << (position - first);
+      mask_[position] = mask;
+    }
+    table_[block] = parent_[first + __builtin_ctz(mask)];
+  }
+
+  // Each level of the sparse table covers twice as many blocks as the one before
+  table_.reserve(size_t(32 - __builtin_clz(blocks_)) * blocks_);
+  for (int span = 1; 2 * span <= blocks_; span *= 2) {
+    size_t previous = table_.size() - blocks_;
+    table_.resize(table_.size() + blocks_);
+    for (int block = 0; block + 2 * span <= blocks_; block++) {
+      table_[previous + blocks_ + block] = std::min(table_[previous + block], table_[previous + block + span]);
+    }
+  }
+
+  buildSeconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int32_t DistanceOracle::blockMinimum(int first, int last) const {
+  uint32_t mask = mask_[last] & (~uint32_t(0) << (first % BLOCK));
+  return parent_[last - last % BLOCK + __builtin_ctz(mask)];
+}
+
+int32_t DistanceOracle::ancestor(int32_t a, int32_t b) const {
+  if (a == b) {
+    return a;
+  }
+  if (a > b) {
+    std::swap(a, b);
+  }
+
+  int first = a + 1;
+  int last = b;
+  int firstBlock = first / BLOCK;
+  int lastBlock = last / BLOCK;
+  if (firstBlock == lastBlock) {
+    return blockMinimum(first, last);
+  }
+
+  int32_t minimum = std::min(blockMinimum(first, firstBlock * BLOCK + BLOCK - 1),
+                             blockMinimum(lastBlock * BLOCK, last));
+  int span = lastBlock - firstBlock - 1;
+  if (span > 0) {
+    int level = 31 - __builtin_clz(span);
+    const int32_t* row = table_.data() + size_t(level) * blocks_;
+    minimum = std::min({minimum, row[firstBlock + 1], row[lastBlock - (1 << level)]});
+  }
+  return minimum;
+}
+
+int32_t DistanceOracle::levelAncestor(int32_t node, int32_t depth) const {
+  while (depth_[node] > depth) {
+    node = depth_[jump_[node]] >= depth ? jump_[node] : parent_[node];
+  }
+  return node;
+}
+
+int32_t DistanceOracle::distance(int a, int b) const {
+  int32_t first = preorder_[a];
+  int32_t second = preorder_[b];
+  return depth_[first] + depth_[second] - 2 * depth_[ancestor(first, second)];
+}
+
+int DistanceOracle::midpoint(int a, int b) const {
+  int32_t first = preorder_[a];
+  int32_t second = preorder_[b];
+  int32_t top = depth_[ancestor(first, second)];
+  int32_t up = depth_[first] - top;
+  int32_t steps = (up + depth_[second] - top) / 2;
+  if (steps <= up) {
+    return cell_[levelAncestor(first, depth_[first] - steps)];
+  }
+  return cell_[levelAncestor(second, top + (steps - up))];
+}
+
+size_t DistanceOracle::memoryBytes() const {
+  return sizeof(int32_t) * (preorder_.capacity() + cell_.capacity() + depth_.capacity() + parent_.capacity() +
+                            jump_.capacity() + table_.capacity()) +
+         sizeof(uint32_t) * mask_.capacity();
+}
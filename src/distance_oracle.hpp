@@ -0,0 +1,114 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DISTANCE_ORACLE_HPP
+#define DISTANCE_ORACLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "grid.hpp"
+
+/**
+ * @class DistanceOracle
+ * @brief Answers distance queries on a perfect maze in constant time.
+ *
+ * The passages of a perfect maze form a spanning tree, so the distance between
+ * two cells is depth(a) + depth(b) - 2 * depth(lca(a, b)) for the tree rooted at
+ * the first cell. The index numbers the cells in depth-first preorder. For two
+ * cells a and b with preorder numbers i < j, the lowest common ancestor is the
+ * parent with the smallest preorder number among the cells numbered i + 1 to j,
+ * which turns every query into a range minimum over the parents.
+ *
+ * The range minimum uses blocks of 32 parents: a sparse table over the block
+ * minima answers whole blocks, and for every position a bit mask of the cells
+ * that are smaller than everything after them within the block answers the
+ * partial blocks with a single bit scan. Path midpoints additionally need level
+ * ancestors, which skew-binary jump pointers find in O(log n) steps with a
+ * single extra pointer per cell.
+ *
+ * The index takes about 24 bytes per cell.
+ */
+class DistanceOracle {
+ private:
+  static constexpr int BLOCK = 32; /**< The number of positions covered by one bit mask. */
+
+  std::vector<int32_t> preorder_; /**< The preorder number of every cell. */
+  std::vector<int32_t> cell_; /**< The cell with every preorder number. */
+  std::vector<int32_t> depth_; /**< The depth of every preorder number. */
+  std::vector<int32_t> parent_; /**< The preorder number of the parent of every preorder number. */
+  std::vector<int32_t> jump_; /**< The preorder number of the jump pointer of every preorder number. */
+  std::vector<uint32_t> mask_; /**< The in-block suffix minima ending at every position. */
+  std::vector<int32_t> table_; /**< Sparse table over block minima, one level after another. */
+  int blocks_ = 0; /**< The number of blocks, and the length of each level of the table. */
+  double buildSeconds_ = 0; /**< The time taken to build the index. */
+
+  /**
+   * @brief Returns the smallest parent between two positions of the same block, inclusive.
+   */
+  int32_t blockMinimum(int first, int last) const;
+
+  /**
+   * @brief Returns the preorder number of the lowest common ancestor of two preorder numbers.
+   */
+  int32_t ancestor(int32_t a, int32_t b) const;
+
+  /**
+   * @brief Returns the ancestor of a preorder number at the given depth.
+   */
+  int32_t levelAncestor(int32_t node, int32_t depth) const;
+
+ public:
+  /**
+   * @brief Builds the index for a maze.
+   * @param grid The maze, which must be perfect. It is not referenced after construction.
+   * @throws std::invalid_argument if the passages of the grid do not form a spanning tree.
+   */
+  explicit DistanceOracle(const Grid& grid);
+
+  /**
+   * @brief Returns the number of steps on the path between two cells given by index.
+   */
+  int32_t distance(int a, int b) const;
+
+  /**
+   * @brief Returns the cell halfway along the path between two cells given by index.
+   *
+   * If the path has an odd number of steps, the cell nearer to `a` is returned.
+   */
+  int midpoint(int a, int b) const;
+
+  /**
+   * @brief Returns the time in seconds it took to build the index.
+   */
+  double buildSeconds() const { return buildSeconds_; }
+
+  /**
+   * @brief Returns the number of bytes of memory held by the index.
+   */
+  size_t memoryBytes() const;
+};
+
+#endif  // DISTANCE_ORACLE_HPP
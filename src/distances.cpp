@@ -0,0 +1,101 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "distances.hpp"
+
+#include <algorithm>
+
+Distances::Distances(const Grid& grid) {
+  reset(grid);
+}
+
+void Distances::reset(const Grid& grid) {
+  grid_ = &grid;
+  distance_.resize(grid.size());
+  queue_.resize(grid.size());
+  reached_ = 0;
+}
+
+void Distances::from(int source) {
+  search(&source, 1);
+}
+
+void Distances::from(const std::vector<int>& sources) {
+  search(sources.data(), sources.size());
+}
+
+void Distances::search(const int* sources, size_t count) {
+  int32_t* distance = distance_.data();
+  int32_t* queue = queue_.data();
+  std::fill(distance_.begin(), distance_.end(), UNREACHED);
+
+  int tail = 0;
+  for (size_t i = 0; i < count; i++) {
+    int source = sources[i];
+    if (distance[source] != 0) {
+      distance[source] = 0;
+      queue[tail++] = source;
+    }
+  }
+
+  // The queue doubles as the record of visited cells in order of distance
+  for (int head = 0; head < tail; head++) {
+    int cell = queue[head];
+    int32_t next = distance[cell] + 1;
+    grid_->eachLink(cell, [&](int neighbor) {
+      if (distance[neighbor] == UNREACHED) {
+        distance[neighbor] = next;
+        queue[tail++] = neighbor;
+      }
+    });
+  }
+  reached_ = tail;
+}
+
+bool Distances::pathTo(int target, std::vector<int>& path) const {
+  int32_t length = distance_[target];
+  if (length == UNREACHED) {
+    path.clear();
+    return false;
+  }
+
+  const uint8_t* passages = grid_->data();
+  const int columns = grid_->getColumns();
+  path.resize(length + 1);
+  int cell = target;
+  for (int32_t step = length; step > 0; step--) {
+    path[step] = cell;
+    if ((passages[cell] & Grid::LINK_EAST) && distance_[cell + 1] == step - 1) {
+      cell = cell + 1;
+    } else if ((passages[cell] & Grid::LINK_SOUTH) && distance_[cell + columns] == step - 1) {
+      cell = cell + columns;
+    } else if (cell > 0 && (passages[cell - 1] & Grid::LINK_EAST) && distance_[cell - 1] == step - 1) {
+      cell = cell - 1;
+    } else {
+      cell = cell - columns;
+    }
+  }
+  path[0] = cell;
+  return true;
+}
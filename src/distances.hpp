@@ -0,0 +1,115 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DISTANCES_HPP
+#define DISTANCES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "grid.hpp"
+
+/**
+ * @class Distances
+ * @brief Breadth-first distances from one or more source cells to every cell of a maze.
+ *
+ * The distances are stored in a flat array indexed like the cells of the grid,
+ * next to a flat queue of the same size. Both are allocated once and reused by
+ * every following search, so measuring many mazes of the same size never
+ * allocates. The search reads the passage bytes of the grid directly: a cell's
+ * east and south passages are its own bits, its west and north passages are the
+ * east and south bits of the neighbors in those directions.
+ */
+class Distances {
+ private:
+  const Grid* grid_; /**< The maze that is measured. */
+  std::vector<int32_t> distance_; /**< Distance of every cell, UNREACHED if not reached. */
+  std::vector<int32_t> queue_; /**< The cells in the order they were reached. */
+  int reached_ = 0; /**< The number of cells reached by the last search. */
+
+  /**
+   * @brief Runs the breadth-first search from the given source cells.
+   */
+  void search(const int* sources, size_t count);
+
+ public:
+  static constexpr int32_t UNREACHED = -1; /**< Distance of cells not connected to any source. */
+
+  /**
+   * @brief Creates the buffers for measuring the given grid.
+   * @param grid The maze to measure. It must outlive this object or be replaced with reset().
+   */
+  explicit Distances(const Grid& grid);
+
+  /**
+   * @brief Switches to measuring another grid, growing the buffers only if it is larger.
+   */
+  void reset(const Grid& grid);
+
+  /**
+   * @brief Computes the distance of every cell from a single source cell.
+   * @param source The index of the source cell.
+   */
+  void from(int source);
+
+  /**
+   * @brief Computes the distance of every cell from the nearest of several source cells.
+   * @param sources The indices of the source cells.
+   */
+  void from(const std::vector<int>& sources);
+
+  /**
+   * @brief Returns the distance of the cell with the given index from the nearest source.
+   */
+  int32_t operator[](int index) const { return distance_[index]; }
+
+  /**
+   * @brief Returns the number of cells reached by the last search, including the sources.
+   */
+  int reached() const { return reached_; }
+
+  /**
+   * @brief Returns the index of a cell farthest from the sources, or -1 before the first search.
+   */
+  int farthest() const { return reached_ > 0 ? queue_[reached_ - 1] : -1; }
+
+  /**
+   * @brief Returns the largest distance of any reached cell.
+   */
+  int32_t maximum() const { return reached_ > 0 ? distance_[farthest()] : UNREACHED; }
+
+  /**
+   * @brief Reconstructs a shortest path from the nearest source to a target cell.
+   *
+   * The path is found by stepping from the target to any linked neighbor that
+   * is one step closer to a source, so no parent array is needed.
+   * @param target The index of the target cell.
+   * @param path Receives the cell indices from the source to the target. Its storage is reused.
+   * @return False if the target was not reached, in which case `path` is empty.
+   */
+  bool pathTo(int target, std::vector<int>& path) const;
+};
+
+#endif  // DISTANCES_HPP
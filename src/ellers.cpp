@@ -0,0 +1,86 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ellers.hpp"
+
+#include <algorithm>
+
+Stats Ellers::on(Grid* grid, Random& random) {
+  Stats stats;
+  {
+    STATS_PHASE(stats, "rows");
+    GridRowSink sink(grid);
+    stats.merge(stream(grid->getRows(), grid->getColumns(), random, sink));
+  }
+  return stats;
+}
+
+Stats Ellers::stream(int64_t rows, int columns, Random& random, RowSink& sink) {
+  Stats stats;
+  // Each column starts in a set of its own.
+  std::vector<int> left(columns);
+  std::vector<int> right(columns);
+  for (int column = 0; column < columns; column++) {
+    left[column] = right[column] = column;
+  }
+  std::vector<uint8_t> passages(columns);
+  STATS_ALLOCATION(stats, left.size() * sizeof(int));
+  STATS_ALLOCATION(stats, right.size() * sizeof(int));
+  STATS_ALLOCATION(stats, passages.size());
+
+  for (int64_t row = 0; row < rows; row++) {
+    bool lastRow = (row == rows - 1);
+    std::fill(passages.begin(), passages.end(), 0);
+
+    // Randomly join adjacent cells of different sets; the last row joins all of them.
+    for (int column = 0; column + 1 < columns; column++) {
+      if (left[column + 1] != column && (lastRow || random.coin())) {
+        right[left[column + 1]] = right[column];
+        left[right[column]] = left[column + 1];
+        right[column] = column + 1;
+        left[column + 1] = column;
+        passages[column] |= Grid::LINK_EAST;
+        STATS_COUNT(stats, links, 1);
+      }
+    }
+
+    // Carve south from every cell, except that a cell which is not the last of its
+    // set may leave the set instead. That keeps at least one passage per set.
+    if (!lastRow) {
+      for (int column = 0; column < columns; column++) {
+        if (left[column] != column && random.coin()) {
+          right[left[column]] = right[column];
+          left[right[column]] = left[column];
+          left[column] = right[column] = column;
+        } else {
+          passages[column] |= Grid::LINK_SOUTH;
+          STATS_COUNT(stats, links, 1);
+        }
+      }
+    }
+
+    sink.writeRow(passages.data(), columns);
+  }
+  return stats;
+}
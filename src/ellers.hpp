@@ -0,0 +1,76 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ELLERS_HPP
+#define ELLERS_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "grid.hpp"
+#include "random.hpp"
+#include "row_sink.hpp"
+#include "stats.hpp"
+
+/**
+ * @class Ellers
+ * @brief Represents Eller's maze generation algorithm.
+ *
+ * Eller's algorithm builds the maze one row at a time and only ever needs the
+ * current row in memory. Each cell of the row belongs to a set of cells that are
+ * already connected through the rows above. Adjacent cells of different sets are
+ * randomly joined, then every set carves at least one passage south into the next
+ * row, whose remaining cells start in sets of their own. The last row joins every
+ * remaining set, which yields a perfect maze.
+ *
+ * The sets of a row never interleave, so they are kept as circular, sorted linked
+ * lists of columns: two adjacent columns are in the same set exactly when one is
+ * the other's predecessor, and joining or leaving a set takes constant time.
+ */
+class Ellers {
+ public:
+  /**
+   * Generates a maze using Eller's algorithm on the given grid.
+   *
+   * @param grid The grid on which the maze is generated.
+   * @param random The random number generator to draw from.
+   * @return The counters collected while generating the maze.
+   */
+  static Stats on(Grid* grid, Random& random);
+
+  /**
+   * Generates a maze using Eller's algorithm and writes it to a sink row by row.
+   *
+   * Memory use is O(columns) regardless of the number of rows.
+   *
+   * @param rows The number of rows of the maze.
+   * @param columns The number of columns of the maze.
+   * @param random The random number generator to draw from.
+   * @param sink The sink receiving each finished row.
+   * @return The counters collected while generating the maze.
+   */
+  static Stats stream(int64_t rows, int columns, Random& random, RowSink& sink);
+};
+
+#endif  // ELLERS_HPP
@@ -24,205 +24,124 @@
 
 #include "grid.hpp"
 
-Grid::Grid(int rows, int columns) : rows(rows), columns(columns) {
-  grid = prepareGrid();
-  configureCells();
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "parallel.hpp"
+#include "maze_file.hpp"
+#include "png_writer.hpp"
+#include "row_sink.hpp"
+#include "text_writer.hpp"
+
+Grid::Grid(int rows, int columns) : rows(0), columns(0) {
+  reset(rows, columns);
 }
 
-std::vector<std::vector<Cell*>> Grid::prepareGrid() {
-  std::vector<std::vector<Cell*>> newGrid(rows, std::vector<Cell*>(columns, nullptr));
-  for (int row = 0; row < rows; row++) {
-    for (int column = 0; column < columns; column++) {
-      newGrid[row][column] = new Cell(row, column);
-    }
+void Grid::reset(int rows, int columns) {
+  if (rows <= 0 || columns <= 0 || rows > std::numeric_limits<int>::max() / columns) {
+    throw std::invalid_argument("Grid dimensions must be positive and the cell count must fit in an int");
   }
-  return newGrid;
+  this->rows = rows;
+  this->columns = columns;
+  prepareGrid();
 }
 
-void Grid::configureCells() {
-  for (int row = 0; row < rows; row++) {
-    for (int column = 0; column < columns; column++) {
-      Cell* cell = grid[row][column];
-      cell->north_ = getCell(row - 1, column);
-      cell->south_ = getCell(row + 1, column);
-      cell->west_ = getCell(row, column - 1);
-      cell->east_ = getCell(row, column + 1);
-    }
-  }
+void Grid::prepareGrid() {
+  grid.assign(static_cast<size_t>(rows) * columns, 0);
 }
 
-Cell* Grid::getCell(int row, int column) {
+Cell Grid::getCell(int row, int column) {
   if (row < 0 || row >= rows || column < 0 || column >= columns) {
-    return nullptr;
+    return Cell();
   }
-  return grid[row][column];
+  return Cell(this, row, column);
 }
 
-Cell* Grid::getRandomCell() {
-  int row = rand() % rows;
-  int column = rand() % columns;
+Cell Grid::getRandomCell(Random& random) {
+  int row = random.below(rows);
+  int column = random.below(columns);
   return getCell(row, column);
 }
 
-int Grid::size() {
-  return rows * columns;
-}
-
-void Grid::eachRow(std::function<void(std::vector<Cell*>&)> callback) {
+void Grid::eachRow(std::function<void(std::vector<Cell>&)> callback) {
+  std::vector<Cell> cells;
+  cells.reserve(columns);
   for (int row = 0; row < rows; row++) {
-    callback(grid[row]);
+    cells.clear();
+    for (int column = 0; column < columns; column++) {
+      cells.emplace_back(this, row, column);
+    }
+    callback(cells);
   }
 }
 
-void Grid::eachCell(std::function<void(Cell*)> callback) {
+void Grid::eachCell(std::function<void(Cell)> callback) {
   for (int row = 0; row < rows; row++) {
     for (int column = 0; column < columns; column++) {
-      callback(grid[row][column]);
+      callback(Cell(this, row, column));
     }
   }
 }
 
-std::string Grid::to_s_v1() {
-  std::string output = "+";
-  for (int i = 0; i < columns; i++) {
-    output += "---+";
-  }
-  output += "\n";
-
-  for (auto row : grid) {
-    std::string top = "|";
-    std::string bottom = "+";
-
-    for (auto cell : row) {
-      if (!cell) {
-        cell = new Cell(-1, -1);
-      }
-
-      std::string body = "   ";
-      std::string east_boundary = (cell->isLinked(cell->east_) ? " " : "|");
-      top += body + east_boundary;
-
-      std::string south_boundary = (cell->isLinked(cell->south_) ? "   " : "---");
-      std::string corner = "+";
-      bottom += south_boundary + corner;
-    }
+std::string Grid::to_s_v1() const {
+  std::ostringstream out;
+  TextWriter writer(out);
+  writeRows(writer);
+  writer.finish();
+  return out.str();
+}
 
-    output += top + "\n";
-    output += bottom + "\n";
+void Grid::eachRowInParallel(int threads, const std::function<void(int)>& callback) {
+  for (int parity = 0; parity < 2; parity++) {
+    parallelFor((rows - parity + 1) / 2, threads, [&](int item, int) {
+      callback(parity + 2 * item);
+    });
   }
-
-  std::cout << output;
-  return output;
 }
 
-void Grid::drawWall(int x1, int x2, int y1, int y2, int wallSize, int cellSize, png_bytep* rowPointers, bool isVertical) {
-  if (isVertical) {
-    for (int y = y1; y < y2; y++) {
-      for (int t = 0; t < wallSize; t++) {
-        if (x1 - t >= 0) {
-          rowPointers[y][(x1 - t -1) * 3] = 0;
-          rowPointers[y][(x1 - t -1) * 3 + 1] = 0;
-          rowPointers[y][(x1 - t -1) * 3 + 2] = 0;
-        }
-      }
-    }
-  }
-  else {
-    for (int x = x1; x < x2; x++) {
-      for (int t = 0; t < wallSize; t++) {
-        if (x >= columns * cellSize) {
-          break;
-        }
-        rowPointers[y1 + t][x * 3] = 0;
-        rowPointers[y1 + t][x * 3 + 1] = 0;
-        rowPointers[y1 + t][x * 3 + 2] = 0;
-      }
+void Grid::place(const Grid& part, int row, int column) {
+  for (int partRow = 0; partRow < part.rows; partRow++) {
+    uint8_t* target = grid.data() + index(row + partRow, column);
+    const uint8_t* source = part.grid.data() + part.index(partRow, 0);
+    for (int partColumn = 0; partColumn < part.columns; partColumn++) {
+      // The last column and row of the part keep the passages leaving it
+      uint8_t keep = 0;
+      if (partColumn == part.columns - 1) keep |= LINK_EAST;
+      if (partRow == part.rows - 1) keep |= LINK_SOUTH;
+      target[partColumn] = (target[partColumn] & keep) | (source[partColumn] & ~keep);
     }
   }
 }
 
-void Grid::generateImage(const std::string& filename, int cellSize, int wallSize) {
-  int imageWidth = columns * cellSize;
-  int imageHeight = rows * cellSize;
-
-  png_bytep* rowPointers = new png_bytep[imageHeight];
-  for (int i = 0; i < imageHeight; i++) {
-    rowPointers[i] = new png_byte[imageWidth * 3];
-    // Initialize all pixels to white
-    std::fill_n(rowPointers[i], imageWidth * 3, 255);
-  }
-
+void Grid::writeRows(RowSink& sink) const {
   for (int row = 0; row < rows; row++) {
-    for (int column = 0; column < columns; column++) {
-      Cell* cell = grid[row][column];
-      int x1 = column * cellSize;
-      int y1 = row * cellSize;
-      int x2 = (column + 1) * cellSize;
-      int y2 = (row + 1) * cellSize;
-
-      if (!cell->isLinked(cell->north_)) {
-        //drawWall(x1, x2, y1, y1 + wallSize, wallSize, rowPointers, false);
-        drawWall(x1, x2 + wallSize, y1, y2, wallSize, cellSize, rowPointers, false);
-      }
-
-      if (!cell->isLinked(cell->west_)) {
-        drawWall(x1 + wallSize, x1, y1, y2, wallSize, cellSize, rowPointers, true);
-      }
-
-      // Draw east wall only if it's the last column and if the cell is not linked to its eastern neighbor
-      if (column == columns - 1 && !cell->isLinked(cell->east_)) {
-        drawWall(x2, x2, y1, y2, wallSize, cellSize, rowPointers, true);
-      }
-
-      // Draw south wall only if it's the last row and if the cell is not linked to its southern neighbor
-      if (row == rows - 1 && !cell->isLinked(cell->south_)) {
-        drawWall(x1, x2, y2 - wallSize, y2, wallSize, cellSize, rowPointers, false);
-      }
-    }
-  }
-
-  // Error handling
-  FILE* file = fopen(filename.c_str(), "wb");
-  if (!file) {
-    std::cerr << "Error opening file: " << filename << std::endl;
-    return;
+    sink.writeRow(grid.data() + index(row, 0), columns);
   }
+}
 
-  png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
-  if (!png) {
-    std::cerr << "Error creating PNG write struct" << std::endl;
-    fclose(file);
-    return;
+bool Grid::save(const std::string& filename, const std::string& algorithm, uint64_t seed) const {
+  MazeFileWriter writer(filename, rows, columns, algorithm, seed);
+  if (!writer.good()) {
+    return false;
   }
+  writeRows(writer);
+  return writer.finish();
+}
 
-  png_infop info = png_create_info_struct(png);
-  if (!info) {
-    std::cerr << "Error creating PNG info struct" << std::endl;
-    png_destroy_write_struct(&png, nullptr);
-    fclose(file);
-    return;
+bool Grid::generateImage(const std::string& filename, int cellSize, int wallSize, int threads,
+                         bool monochrome, int start, int goal) const {
+  PngWriter writer(filename, rows, columns, cellSize, wallSize, threads,
+                   monochrome ? PngWriter::MONOCHROME : PngWriter::RGB);
+  if (!writer.good()) {
+    return false;
   }
-
-  if (setjmp(png_jmpbuf(png))) {
-    std::cerr << "Error during PNG creation" << std::endl;
-    png_destroy_write_struct(&png, &info);
-    fclose(file);
-    return;
+  if (start >= 0) {
+    writer.mark(start / columns, start % columns, 0x00, 0xB0, 0x00);
   }
-
-  // Write image data to file
-  png_init_io(png, file);
-  png_set_IHDR(png, info, imageWidth, imageHeight, 8, PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
-  png_write_info(png, info);
-  png_write_image(png, rowPointers);
-  png_write_end(png, nullptr);
-
-  // Clean up memory
-  for (int i = 0; i < imageHeight; i++) {
-    delete[] rowPointers[i];
+  if (goal >= 0) {
+    writer.mark(goal / columns, goal % columns, 0xD0, 0x00, 0x00);
   }
-  delete[] rowPointers;
-
-  png_destroy_write_struct(&png, &info);
-  fclose(file);
+  writeRows(writer);
+  return writer.finish();
 }
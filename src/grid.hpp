@@ -25,100 +25,323 @@
 #ifndef GRID_HPP
 #define GRID_HPP
 
-#include <png.h>
-
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <string>
 #include <iostream>
+#include <utility>
 #include <vector>
 
+#include "bitset.hpp"
 #include "cell.hpp"
+#include "random.hpp"
+
+class RowSink;
 
+/**
+ * @class Grid
+ * @brief A rectangular maze grid stored as a flat, row-major array of passage bits.
+ *
+ * Every cell occupies a single byte. A cell only records the passages to its
+ * eastern and southern neighbors; the northern and western passages of a cell are
+ * the southern and eastern passages of the neighbors in that direction. Neighbors
+ * are computed from the cell index, so no per-cell objects are allocated and the
+ * whole maze lives in one contiguous buffer.
+ *
+ * A grid owns its buffer and can be moved but not copied, so a maze is never
+ * duplicated by accident; generators carve the grid they are given in place.
+ * Moving a grid leaves the source empty and invalidates the Cell views of it.
+ */
 class Grid {
  private:
     int rows; /**< The number of rows in the grid. */
     int columns; /**< The number of columns in the grid. */
-    std::vector<std::vector<Cell*>> grid; /**< The 2D vector representing the grid of cells. */
+    std::vector<uint8_t> grid; /**< Row-major passage bits, one byte per cell. */
 
  public:
+    static constexpr uint8_t LINK_EAST = 0x1; /**< Passage to the eastern neighbor. */
+    static constexpr uint8_t LINK_SOUTH = 0x2; /**< Passage to the southern neighbor. */
+
+    /**
+     * @brief The four directions a cell can have neighbors in.
+     */
+    enum Direction : uint8_t { NORTH = 0, SOUTH = 1, EAST = 2, WEST = 3 };
+
+    static constexpr int ROW_STEP[4] = {-1, 1, 0, 0}; /**< Row offset of each Direction. */
+    static constexpr int COLUMN_STEP[4] = {0, 0, 1, -1}; /**< Column offset of each Direction. */
+
+    /** Number of neighbors for each neighborMask() value. */
+    static constexpr uint8_t NEIGHBOR_COUNT[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+    /** The Directions set in each neighborMask() value, in ascending order. */
+    static constexpr uint8_t NEIGHBOR_DIRECTIONS[16][4] = {
+      {0, 0, 0, 0}, {0, 0, 0, 0}, {1, 0, 0, 0}, {0, 1, 0, 0},
+      {2, 0, 0, 0}, {0, 2, 0, 0}, {1, 2, 0, 0}, {0, 1, 2, 0},
+      {3, 0, 0, 0}, {0, 3, 0, 0}, {1, 3, 0, 0}, {0, 1, 3, 0},
+      {2, 3, 0, 0}, {0, 2, 3, 0}, {1, 2, 3, 0}, {0, 1, 2, 3},
+    };
+
     /**
      * @brief Constructs a Grid object with the specified number of rows and columns.
      * @param rows The number of rows in the grid.
      * @param columns The number of columns in the grid.
+     * @throws std::invalid_argument if the dimensions are not positive or the cell count does not fit in an int.
      */
     Grid(int rows, int columns);
 
+    Grid(const Grid&) = delete;
+    Grid& operator=(const Grid&) = delete;
+
+    /**
+     * @brief Takes over the cells of another grid, which is left with no cells.
+     */
+    Grid(Grid&& other) noexcept : rows(other.rows), columns(other.columns), grid(std::move(other.grid)) {
+      other.rows = other.columns = 0;
+    }
+
     /**
-     * @brief Prepares the grid by creating and initializing the cells.
-     * @return The 2D vector representing the grid of cells.
+     * @brief Takes over the cells of another grid, which is left with no cells.
+     */
+    Grid& operator=(Grid&& other) noexcept {
+      if (this != &other) {
+        rows = std::exchange(other.rows, 0);
+        columns = std::exchange(other.columns, 0);
+        grid = std::move(other.grid);
+        other.grid.clear();
+      }
+      return *this;
+    }
+
+    /**
+     * @brief Changes the size of the grid and closes every wall.
+     *
+     * The cell storage is only reallocated if the new grid has more cells than
+     * the grid ever had, so a grid can be reused for many mazes without touching
+     * the allocator.
+     * @param rows The new number of rows.
+     * @param columns The new number of columns.
+     * @throws std::invalid_argument if the dimensions are not positive or the cell count does not fit in an int.
      */
-    std::vector<std::vector<Cell*>> prepareGrid();
+    void reset(int rows, int columns);
 
     /**
-     * @brief Configures the cells in the grid.
+     * @brief Prepares the grid by allocating the cell storage with every wall closed.
      */
-    void configureCells();
+    void prepareGrid();
 
     /**
      * @brief Retrieves the cell at the specified row and column.
      * @param row The row index of the cell.
      * @param column The column index of the cell.
-     * @return A pointer to the cell at the specified position, or nullptr if the position is out of bounds.
+     * @return A view of the cell at the specified position, or a null cell if the position is out of bounds.
      */
-    Cell* getCell(int row, int column);
+    Cell getCell(int row, int column);
 
     /**
      * @brief Retrieves a random cell from the grid.
-     * @return A pointer to a randomly selected cell.
+     * @param random The random number generator to draw from.
+     * @return A view of a randomly selected cell.
      */
-    Cell* getRandomCell();
+    Cell getRandomCell(Random& random);
 
     /**
      * @brief Returns the total number of cells in the grid.
      * @return The total number of cells in the grid.
      */
-    int size();
+    int size() const { return rows * columns; }
+
+    /**
+     * @brief Returns the number of rows in the grid.
+     */
+    int getRows() const { return rows; }
+
+    /**
+     * @brief Returns the number of columns in the grid.
+     */
+    int getColumns() const { return columns; }
 
     /**
      * @brief Iterates over each row in the grid.
-     * @return A vector of cell rows.
+     *
+     * The row vector passed to the callback is reused between rows.
      */
-    void eachRow(std::function<void(std::vector<Cell*>&)>);
+    void eachRow(std::function<void(std::vector<Cell>&)>);
 
     /**
      * @brief Iterates over each cell in the grid.
-     * @return A vector of cells.
      */
-    void eachCell(std::function<void(Cell*)>);
+    void eachCell(std::function<void(Cell)>);
+
+    /**
+     * @brief Runs a function for every row index, using several threads.
+     *
+     * The function may change the passages of the cells in its row and the south
+     * passages of the row above, which is all a generator that only carves north
+     * and east touches. Even rows are processed first and odd rows second, so no
+     * two concurrent calls ever write to the same cell.
+     * @param threads The number of threads to use.
+     * @param callback The function to run with each row index.
+     */
+    void eachRowInParallel(int threads, const std::function<void(int)>& callback);
+
+    /**
+     * @brief Returns the row-major index of the cell at the given position.
+     */
+    int index(int row, int column) const { return row * columns + column; }
+
+    /**
+     * @brief Returns a mask with bit (1 << Direction) set for every neighbor the cell has.
+     */
+    uint8_t neighborMask(int row, int column) const {
+      return (row > 0) << NORTH | (row < rows - 1) << SOUTH |
+             (column < columns - 1) << EAST | (column > 0) << WEST;
+    }
+
+    /**
+     * @brief Returns a neighborMask() of the neighbors whose bit in the given set equals state.
+     * @param index The index of the cell at row and column.
+     * @param cells One bit per cell of the grid, such as the visited cells of a generator.
+     */
+    uint8_t neighborMask(int index, int row, int column, const Bitset& cells, bool state) const {
+      uint8_t mask = neighborMask(row, column);
+      if ((mask & (1 << NORTH)) && cells.test(index - columns) != state) mask &= ~(1 << NORTH);
+      if ((mask & (1 << SOUTH)) && cells.test(index + columns) != state) mask &= ~(1 << SOUTH);
+      if ((mask & (1 << EAST)) && cells.test(index + 1) != state) mask &= ~(1 << EAST);
+      if ((mask & (1 << WEST)) && cells.test(index - 1) != state) mask &= ~(1 << WEST);
+      return mask;
+    }
+
+    /**
+     * @brief Picks a random direction of a non-empty neighborMask() value.
+     * @note A single direction is returned without drawing a random number.
+     */
+    static Direction randomDirection(uint8_t mask, Random& random) {
+      uint8_t count = NEIGHBOR_COUNT[mask];
+      return static_cast<Direction>(NEIGHBOR_DIRECTIONS[mask][count > 1 ? random.below(count) : 0]);
+    }
+
+    /**
+     * @brief Picks a random neighbor direction of a cell without building a neighbor list.
+     * @param random The random number generator to draw from.
+     * @note The cell must have at least one neighbor, i.e. the grid must have more than one cell.
+     */
+    Direction randomDirection(int row, int column, Random& random) const {
+      uint8_t mask = neighborMask(row, column);
+      return static_cast<Direction>(NEIGHBOR_DIRECTIONS[mask][random.below(NEIGHBOR_COUNT[mask])]);
+    }
+
+    /**
+     * @brief Returns the index offset of the neighbor in the given direction.
+     */
+    int offset(Direction direction) const {
+      return ROW_STEP[direction] * columns + COLUMN_STEP[direction];
+    }
+
+    /**
+     * @brief Returns the passage bits (LINK_EAST, LINK_SOUTH) of the cell at the given index.
+     */
+    uint8_t passages(int index) const { return grid[index]; }
+
+    /**
+     * @brief Carves a passage between two adjacent cells given by index.
+     *
+     * The cells must be horizontal or vertical neighbors; the passage is stored on
+     * whichever of the two lies to the north or west.
+     */
+    void link(int a, int b) {
+      if (a > b) std::swap(a, b);
+      grid[a] |= (b == a + columns) ? LINK_SOUTH : LINK_EAST;
+    }
+
+    /**
+     * @brief Removes the passage between two adjacent cells given by index.
+     */
+    void unlink(int a, int b) {
+      if (a > b) std::swap(a, b);
+      grid[a] &= ~((b == a + columns) ? LINK_SOUTH : LINK_EAST);
+    }
+
+    /**
+     * @brief Checks whether two adjacent cells given by index are linked.
+     */
+    bool isLinked(int a, int b) const {
+      if (a > b) std::swap(a, b);
+      return grid[a] & ((b == a + columns) ? LINK_SOUTH : LINK_EAST);
+    }
+
+    /**
+     * @brief Calls a function with the index of every cell linked to the cell at the given index.
+     *
+     * The neighbors are visited in the order east, south, west, north. The last
+     * column never has an east passage, so the west neighbor needs no column check.
+     */
+    template <typename Visit>
+    void eachLink(int index, Visit&& visit) const {
+      const uint8_t links = grid[index];
+      if (links & LINK_EAST) visit(index + 1);
+      if (links & LINK_SOUTH) visit(index + columns);
+      if (index > 0 && (grid[index - 1] & LINK_EAST)) visit(index - 1);
+      if (index >= columns && (grid[index - columns] & LINK_SOUTH)) visit(index - columns);
+    }
+
+    /**
+     * @brief Returns a pointer to the raw passage bytes, rows() * columns() in row-major order.
+     */
+    uint8_t* data() { return grid.data(); }
+    const uint8_t* data() const { return grid.data(); }
 
     /**
      * @brief Returns a string representation of the grid (version 1).
+     *
+     * The maze is drawn in ASCII by a TextWriter and nothing is printed. To print
+     * a large maze, write its rows to a TextWriter on the output directly instead.
      * @return A string representation of the grid.
      */
-    std::string to_s_v1();
+    std::string to_s_v1() const;
 
     /**
-     * Draws a wall on the grid.
+     * @brief Copies the passages of a smaller grid into this grid.
      *
-     * @param x1 The starting x-coordinate of the wall.
-     * @param x2 The ending x-coordinate of the wall.
-     * @param y1 The starting y-coordinate of the wall.
-     * @param y2 The ending y-coordinate of the wall.
-     * @param wallSize The size of the wall.
-     * @param rowPointers The array of row pointers representing the grid.
-     * @param isVertical Indicates whether the wall is vertical or horizontal.
+     * Passages leading out of the copied region are left untouched.
+     * @param part The grid to copy.
+     * @param row The row at which the first row of `part` is placed.
+     * @param column The column at which the first column of `part` is placed.
+     */
+    void place(const Grid& part, int row, int column);
+
+    /**
+     * @brief Writes every row of the grid to a sink, from north to south.
      */
-    void drawWall(int x1, int x2, int y1, int y2, int wallSize, int cellSize, png_bytep* rowPointers, bool isVertical);
+    void writeRows(RowSink& sink) const;
+
+    /**
+     * @brief Saves the grid as a binary maze file, two bits per cell.
+     * @param filename The name of the output file.
+     * @param algorithm The name of the algorithm that generated the maze, stored in the file.
+     * @param seed The seed the maze was generated from, stored in the file.
+     * @return True if the file was successfully written, false otherwise.
+     * @see MazeFile
+     */
+    bool save(const std::string& filename, const std::string& algorithm = "", uint64_t seed = 0) const;
 
     /**
      * @brief Generates a PNG image of the grid.
+     *
+     * The image is rendered and encoded one maze row at a time by a PngWriter, so
+     * only `cellSize` scanlines are held in memory.
      * @param filename The name of the output image file.
      * @param cellSize The size of each cell in pixels.
+     * @param wallSize The thickness of each wall in pixels.
+     * @param threads The number of threads used to compress the image.
+     * @param monochrome Whether to write a 1-bit grayscale image instead of RGB.
+     * @param start The index of a cell to mark green as the start of a path, or -1.
+     * @param goal The index of a cell to mark red as the goal of a path, or -1.
      * @return True if the image was successfully generated, false otherwise.
      * @note This function requires the libpng library to be installed.
     */
-    void generateImage(const std::string& filename, int cellSize, int wallSize = 1);
+    bool generateImage(const std::string& filename, int cellSize, int wallSize = 1, int threads = 1,
+                       bool monochrome = false, int start = -1, int goal = -1) const;
 };
 
 #endif  // GRID_HPP
@@ -0,0 +1,190 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef GROWING_TREE_HPP
+#define GROWING_TREE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bitset.hpp"
+#include "grid.hpp"
+#include "random.hpp"
+#include "stats.hpp"
+
+/**
+ * @brief Selection policies for GrowingTree, which decide the active cell the tree grows from.
+ *
+ * A policy is a type with a static `select(head, tail, random)` that returns a
+ * position in [head, tail) of the active cells, where tail - 1 always holds the
+ * newest active cell and head the oldest one, unless cells in between have been
+ * removed (see ActiveCells).
+ */
+namespace Selection {
+
+/**
+ * @brief Always grows from the newest cell, which gives the mazes of the recursive backtracker.
+ */
+struct Newest {
+  static size_t select(size_t, size_t tail, ::Random&) { return tail - 1; }
+};
+
+/**
+ * @brief Always grows from the oldest cell, which gives long straight corridors fanning out from the start.
+ */
+struct Oldest {
+  static size_t select(size_t head, size_t, ::Random&) { return head; }
+};
+
+/**
+ * @brief Grows from a random cell, which gives the mazes of simplified Prim's algorithm.
+ */
+struct Random {
+  static size_t select(size_t head, size_t tail, ::Random& random) { return head + random.below(tail - head); }
+};
+
+/**
+ * @brief Grows from the newest cell NEWEST_PERCENT percent of the time and from a random cell otherwise.
+ */
+template <int NEWEST_PERCENT>
+struct Mixed {
+  static_assert(NEWEST_PERCENT >= 0 && NEWEST_PERCENT <= 100, "NEWEST_PERCENT must be a percentage");
+
+  static size_t select(size_t head, size_t tail, ::Random& random) {
+    return random.below(100) < NEWEST_PERCENT ? Newest::select(head, tail, random)
+                                              : Random::select(head, tail, random);
+  }
+};
+
+}  // namespace Selection
+
+/**
+ * @class ActiveCells
+ * @brief The active cells of GrowingTree, a dense array of cell indices between a head and a tail position.
+ *
+ * Cells are pushed at the tail, so tail - 1 always holds the newest cell. A cell
+ * removed from the tail moves the tail and any other hole is filled with the cell
+ * at the head, which moves the head; removal takes constant time and keeps the
+ * newest cell in place for the Newest and Mixed policies.
+ */
+class ActiveCells {
+ public:
+  /**
+   * Allocates room for the given number of cells, as every cell is pushed at most once.
+   */
+  explicit ActiveCells(size_t capacity) : cells_(capacity) {}
+
+  void push(int32_t cell) { cells_[tail_++] = cell; }
+
+  void remove(size_t position) {
+    if (position + 1 == tail_) {
+      tail_--;
+    } else {
+      cells_[position] = cells_[head_++];
+    }
+  }
+
+  int32_t operator[](size_t position) const { return cells_[position]; }
+
+  size_t head() const { return head_; }
+
+  size_t tail() const { return tail_; }
+
+  bool empty() const { return head_ == tail_; }
+
+  size_t bytes() const { return cells_.size() * sizeof(int32_t); }
+
+ private:
+  std::vector<int32_t> cells_;
+  size_t head_ = 0, tail_ = 0;
+};
+
+/**
+ * @class GrowingTree
+ * @brief Represents the Growing Tree maze generation algorithm.
+ *
+ * The Growing Tree algorithm keeps a set of active cells, starting with a random
+ * one. It repeatedly selects an active cell and carves into a random unvisited
+ * neighbor, which becomes active too; an active cell without unvisited neighbors
+ * is removed. The selection policy decides the texture of the maze and is a
+ * template parameter, so it is inlined into the loop.
+ *
+ * The active cells are an ActiveCells array allocated for the whole grid up
+ * front, so every operation takes constant time and nothing is allocated after
+ * the setup.
+ *
+ * @tparam Policy The selection policy, see the Selection namespace.
+ */
+template <typename Policy>
+class GrowingTree {
+ public:
+  /**
+   * Generates a maze using the Growing Tree algorithm on the given grid.
+   *
+   * Uses at most 4 bytes of active array and 1 bit of visited set per cell besides the grid.
+   *
+   * @param grid The grid on which the maze is generated.
+   * @param random The random number generator to draw from.
+   * @return The counters collected while generating the maze.
+   */
+  static Stats on(Grid* grid, Random& random) {
+    Stats stats;
+    int columns = grid->getColumns();
+    Bitset visited(grid->size());
+    ActiveCells active(grid->size());
+    STATS_ALLOCATION(stats, visited.bytes());
+    STATS_ALLOCATION(stats, active.bytes());
+
+    {
+      STATS_PHASE(stats, "carve");
+      int start = random.below(grid->size());
+      visited.set(start);
+      active.push(start);
+
+      while (!active.empty()) {
+        size_t position = Policy::select(active.head(), active.tail(), random);
+        int index = active[position];
+        int row = index / columns;
+        int column = index - row * columns;
+
+        uint8_t mask = grid->neighborMask(index, row, column, visited, false);
+        if (mask == 0) {
+          active.remove(position);
+          continue;
+        }
+
+        int neighbor = index + grid->offset(Grid::randomDirection(mask, random));
+        visited.set(neighbor);
+        grid->link(index, neighbor);
+        STATS_COUNT(stats, links, 1);
+        active.push(neighbor);
+      }
+    }
+
+    return stats;
+  }
+};
+
+#endif  // GROWING_TREE_HPP
@@ -0,0 +1,98 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "hunt_and_kill.hpp"
+
+Stats HuntAndKill::on(Grid* grid, Random& random) {
+  Stats stats;
+  int rows = grid->getRows();
+  int columns = grid->getColumns();
+  Bitset visited(grid->size());
+  Bitset frontier(grid->size());
+  Bitset frontierRows(rows);
+  std::vector<int32_t> frontierCount(rows, 0);
+  STATS_ALLOCATION(stats, visited.bytes());
+  STATS_ALLOCATION(stats, frontier.bytes());
+  STATS_ALLOCATION(stats, frontierRows.bytes());
+  STATS_ALLOCATION(stats, frontierCount.size() * sizeof(int32_t));
+
+  {
+    STATS_PHASE(stats, "carve");
+    int index = random.below(grid->size());
+    int remaining = grid->size();
+
+    while (true) {
+      int row = index / columns;
+      int column = index - row * columns;
+      visited.set(index);
+      if (--remaining == 0) {
+        break;
+      }
+
+      // The cell leaves the frontier, and its unvisited neighbors join it
+      if (frontier.test(index)) {
+        frontier.reset(index);
+        if (--frontierCount[row] == 0) {
+          frontierRows.reset(row);
+        }
+      }
+      uint8_t mask = grid->neighborMask(index, row, column, visited, false);
+      for (int i = 0; i < Grid::NEIGHBOR_COUNT[mask]; i++) {
+        auto direction = static_cast<Grid::Direction>(Grid::NEIGHBOR_DIRECTIONS[mask][i]);
+        int neighbor = index + grid->offset(direction);
+        if (!frontier.test(neighbor)) {
+          frontier.set(neighbor);
+          int neighborRow = row + Grid::ROW_STEP[direction];
+          if (frontierCount[neighborRow]++ == 0) {
+            frontierRows.set(neighborRow);
+          }
+        }
+      }
+
+      // Kill: walk on to a random unvisited neighbor
+      if (mask != 0) {
+        int next = index + grid->offset(Grid::randomDirection(mask, random));
+        grid->link(index, next);
+        STATS_COUNT(stats, links, 1);
+        STATS_COUNT(stats, steps, 1);
+        index = next;
+        continue;
+      }
+
+      // Hunt: the first frontier cell of the first row that has one is the first
+      // unvisited cell next to a visited one
+      int huntRow = frontierRows.findNextOne(0);
+      index = frontier.findNextOne(size_t(huntRow) * columns);
+      row = huntRow;
+      column = index - row * columns;
+      uint8_t neighbors = grid->neighborMask(index, row, column, visited, true);
+      // The walk continues from the hunted cell, so joining it counts as a step too
+      grid->link(index, index + grid->offset(Grid::randomDirection(neighbors, random)));
+      STATS_COUNT(stats, links, 1);
+      STATS_COUNT(stats, steps, 1);
+    }
+  }
+
+  return stats;
+}
@@ -0,0 +1,69 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef HUNT_AND_KILL_HPP
+#define HUNT_AND_KILL_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "bitset.hpp"
+#include "grid.hpp"
+#include "random.hpp"
+#include "stats.hpp"
+
+/**
+ * @class HuntAndKill
+ * @brief Represents the Hunt-and-Kill maze generation algorithm.
+ *
+ * Hunt-and-Kill walks randomly from cell to unvisited neighboring cell, carving
+ * as it goes, until it reaches a cell whose neighbors are all visited. It then
+ * hunts for the first unvisited cell, in row-major order, next to a visited one,
+ * links the two and walks on from there. The mazes look like those of the
+ * recursive backtracker, but no stack is needed.
+ *
+ * A naive hunt rescans the grid from the top after every dead end, which is
+ * quadratic. Here the cells the hunt is looking for, unvisited cells next to a
+ * visited one, are kept up to date in a word-packed frontier bitset as cells are
+ * visited, together with the number of frontier cells in every row and a bitset
+ * of the rows that have any. The hunt then skips every row without frontier cells
+ * 64 rows at a time and finds the first frontier cell of the first remaining row
+ * 64 cells at a time, so the whole algorithm runs in linear time. The maze is the
+ * same as the one a naive hunt produces.
+ */
+class HuntAndKill {
+ public:
+  /**
+   * Generates a maze using Hunt-and-Kill on the given grid.
+   *
+   * Uses 2 bits of memory per cell and 4 bytes per row besides the grid.
+   *
+   * @param grid The grid on which the maze is generated.
+   * @param random The random number generator to draw from.
+   * @return The counters collected while generating the maze.
+   */
+  static Stats on(Grid* grid, Random& random);
+};
+
+#endif  // HUNT_AND_KILL_HPP
@@ -0,0 +1,97 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "kruskals.hpp"
+
+namespace {
+
+/** How many edges ahead the cells of an edge are prefetched. */
+constexpr size_t PREFETCH = 16;
+
+}  // namespace
+
+Stats Kruskals::on(Grid* grid, Random& random) {
+  Stats stats;
+  int rows = grid->getRows();
+  int columns = grid->getColumns();
+  std::vector<uint32_t> edges;
+  DisjointSet sets(grid->size());
+  STATS_ALLOCATION(stats, sets.bytes());
+
+  {
+    STATS_PHASE(stats, "edges");
+    edges.reserve(size_t(rows) * (columns - 1) + size_t(rows - 1) * columns);
+    STATS_ALLOCATION(stats, edges.capacity() * sizeof(uint32_t));
+    for (int row = 0; row < rows; row++) {
+      uint32_t cell = grid->index(row, 0);
+      for (int column = 0; column < columns; column++, cell++) {
+        if (column < columns - 1) edges.push_back(2 * cell);
+        if (row < rows - 1) edges.push_back(2 * cell + 1);
+      }
+    }
+  }
+
+  {
+    STATS_PHASE(stats, "shuffle");
+    // Every swap partner is drawn PREFETCH steps ahead of its swap and prefetched,
+    // so it is in the cache by the time it is swapped. The draws happen in the
+    // same order as in a plain Fisher-Yates shuffle.
+    uint32_t partners[PREFETCH];
+    uint32_t count = edges.size();
+    for (uint32_t i = count; i > 1 && i + PREFETCH > count; i--) {
+      partners[i % PREFETCH] = random.below(i);
+      __builtin_prefetch(&edges[partners[i % PREFETCH]], 1);
+    }
+    for (uint32_t i = count; i > 1; i--) {
+      uint32_t& partner = partners[i % PREFETCH];
+      std::swap(edges[i - 1], edges[partner]);
+      if (i > PREFETCH + 1) {
+        partner = random.below(i - PREFETCH);
+        __builtin_prefetch(&edges[partner], 1);
+      }
+    }
+  }
+
+  {
+    STATS_PHASE(stats, "join");
+    size_t count = edges.size();
+    int remaining = grid->size() - 1;
+    for (size_t i = 0; remaining > 0; i++) {
+      if (i + PREFETCH < count) {
+        uint32_t ahead = edges[i + PREFETCH];
+        sets.prefetch(ahead >> 1);
+        sets.prefetch((ahead & 1) ? (ahead >> 1) + columns : (ahead >> 1) + 1);
+      }
+      int cell = edges[i] >> 1;
+      int neighbor = (edges[i] & 1) ? cell + columns : cell + 1;
+      if (sets.unite(cell, neighbor)) {
+        grid->link(cell, neighbor);
+        STATS_COUNT(stats, links, 1);
+        remaining--;
+      }
+    }
+  }
+
+  return stats;
+}
@@ -0,0 +1,67 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef KRUSKALS_HPP
+#define KRUSKALS_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "disjoint_set.hpp"
+#include "grid.hpp"
+#include "random.hpp"
+#include "stats.hpp"
+
+/**
+ * @class Kruskals
+ * @brief Represents the randomized Kruskal's maze generation algorithm.
+ *
+ * Every wall between two neighboring cells is an edge of the grid graph. Kruskal's
+ * algorithm visits the edges in random order and removes a wall whenever the two
+ * cells behind it are not connected yet, which it tracks with a DisjointSet of
+ * cells. Once `size() - 1` walls are removed the maze is a spanning tree.
+ *
+ * The edges are kept in one flat array, each encoded as `2 * cell + 0` for the
+ * wall east of the cell and `2 * cell + 1` for the wall south of it, which is
+ * shuffled in place with Fisher-Yates. Both the shuffle and the joins jump
+ * around memory at random, so they prefetch the memory of the swaps and cells a
+ * few steps ahead. The run time only depends on the size of the grid, never on
+ * the luck of a random walk.
+ */
+class Kruskals {
+ public:
+  /**
+   * Generates a maze using Kruskal's algorithm on the given grid.
+   *
+   * Uses about 12 bytes of memory per cell besides the grid: 4 for each of the
+   * two edges of a cell and 4 for the disjoint set.
+   *
+   * @param grid The grid on which the maze is generated.
+   * @param random The random number generator to draw from.
+   * @return The counters collected while generating the maze.
+   */
+  static Stats on(Grid* grid, Random& random);
+};
+
+#endif  // KRUSKALS_HPP
@@ -0,0 +1,211 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "longest_path.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "parallel.hpp"
+
+namespace {
+
+/** The smallest frontier whose top-down expansion is split across threads. */
+constexpr size_t PARALLEL_FRONTIER = 1 << 12;
+
+/** The number of frontier cells, or bitmap words, handed to a worker at a time. */
+constexpr int CHUNK = 1 << 10;
+
+/** Switch to bottom-up once the frontier is larger than the unvisited cells divided by ALPHA. */
+constexpr int64_t ALPHA = 14;
+
+/** Switch back to top-down once the frontier is smaller than all cells divided by BETA. */
+constexpr int64_t BETA = 24;
+
+/**
+ * @brief The buffers of a direction-optimizing breadth-first search, reused by both searches.
+ */
+class FrontierSearch {
+ private:
+  const Grid& grid_;
+  int threads_;
+  int size_;
+  int words_;
+  std::vector<uint64_t> visited_; /**< One bit per cell reached so far. */
+  std::vector<uint64_t> frontier_; /**< The current level, while searching bottom-up. */
+  std::vector<uint64_t> next_; /**< The next level, while searching bottom-up. */
+  std::vector<int32_t> queue_; /**< The current level, while searching top-down. */
+  std::vector<int32_t> following_; /**< The next level, while searching top-down. */
+  std::vector<std::vector<int32_t>> local_; /**< The cells each worker found on the next level. */
+  std::vector<int64_t> counts_; /**< The number of cells each worker found on the next level. */
+
+  void topDown() {
+    following_.clear();
+    if (queue_.size() < PARALLEL_FRONTIER || threads_ == 1) {
+      for (int32_t cell : queue_) {
+        grid_.eachLink(cell, [&](int neighbor) {
+          uint64_t bit = uint64_t(1) << (neighbor & 63);
+          if (!(visited_[neighbor >> 6] & bit)) {
+            visited_[neighbor >> 6] |= bit;
+            following_.push_back(neighbor);
+          }
+        });
+      }
+      return;
+    }
+
+    int chunks = (queue_.size() + CHUNK - 1) / CHUNK;
+    parallelFor(chunks, threads_, [&](int chunk, int worker) {
+      size_t end = std::min(queue_.size(), size_t(chunk + 1) * CHUNK);
+      for (size_t i = size_t(chunk) * CHUNK; i < end; i++) {
+        grid_.eachLink(queue_[i], [&](int neighbor) {
+          uint64_t bit = uint64_t(1) << (neighbor & 63);
+          uint64_t* word = &visited_[neighbor >> 6];
+          if (!(__atomic_load_n(word, __ATOMIC_RELAXED) & bit) &&
+              !(__atomic_fetch_or(word, bit, __ATOMIC_RELAXED) & bit)) {
+            local_[worker].push_back(neighbor);
+          }
+        });
+      }
+    });
+    for (std::vector<int32_t>& cells : local_) {
+      following_.insert(following_.end(), cells.begin(), cells.end());
+      cells.clear();
+    }
+  }
+
+  int64_t bottomUp() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    int chunks = (words_ + CHUNK - 1) / CHUNK;
+    parallelFor(chunks, threads_, [&](int chunk, int worker) {
+      int end = std::min(words_, (chunk + 1) * CHUNK);
+      for (int word = chunk * CHUNK; word < end; word++) {
+        uint64_t unvisited = ~visited_[word];
+        if (word == words_ - 1 && size_ % 64 != 0) {
+          unvisited &= (uint64_t(1) << (size_ % 64)) - 1;
+        }
+        uint64_t found = 0;
+        while (unvisited) {
+          int bit = __builtin_ctzll(unvisited);
+          unvisited &= unvisited - 1;
+          bool reached = false;
+          grid_.eachLink(word * 64 + bit, [&](int neighbor) {
+            reached |= (frontier_[neighbor >> 6] >> (neighbor & 63)) & 1;
+          });
+          found |= uint64_t(reached) << bit;
+        }
+        next_[word] = found;
+        visited_[word] |= found;
+        counts_[worker] += __builtin_popcountll(found);
+      }
+    });
+    int64_t count = 0;
+    for (int64_t workerCount : counts_) {
+      count += workerCount;
+    }
+    return count;
+  }
+
+  void toBitmap() {
+    std::fill(frontier_.begin(), frontier_.end(), 0);
+    for (int32_t cell : queue_) {
+      frontier_[cell >> 6] |= uint64_t(1) << (cell & 63);
+    }
+  }
+
+  void toQueue() {
+    queue_.clear();
+    for (int word = 0; word < words_; word++) {
+      for (uint64_t bits = frontier_[word]; bits; bits &= bits - 1) {
+        queue_.push_back(word * 64 + __builtin_ctzll(bits));
+      }
+    }
+  }
+
+ public:
+  FrontierSearch(const Grid& grid, int threads)
+      : grid_(grid), threads_(std::max(1, threads)), size_(grid.size()), words_((grid.size() + 63) / 64),
+        visited_(words_), frontier_(words_), next_(words_), local_(threads_), counts_(threads_) {}
+
+  /**
+   * @brief Searches from a cell and returns the lowest-numbered cell of the last level.
+   * @param levels Receives the distance of that cell from the source.
+   */
+  int farthest(int source, int32_t& levels) {
+    std::fill(visited_.begin(), visited_.end(), 0);
+    visited_[source >> 6] |= uint64_t(1) << (source & 63);
+    queue_.assign(1, source);
+    int64_t frontier = 1;
+    int64_t unvisited = size_ - 1;
+    bool bitmap = false;
+    levels = 0;
+
+    while (true) {
+      if (!bitmap && queue_.size() >= PARALLEL_FRONTIER && frontier * ALPHA > unvisited) {
+        toBitmap();
+        bitmap = true;
+      } else if (bitmap && (frontier * BETA < size_ || frontier < int64_t(PARALLEL_FRONTIER))) {
+        toQueue();
+        bitmap = false;
+      }
+
+      int64_t found;
+      if (bitmap) {
+        found = bottomUp();
+      } else {
+        topDown();
+        found = following_.size();
+      }
+      if (found == 0) {
+        break;
+      }
+
+      levels++;
+      unvisited -= found;
+      frontier = found;
+      if (bitmap) {
+        std::swap(frontier_, next_);
+      } else {
+        std::swap(queue_, following_);
+      }
+    }
+
+    // The current frontier is the last level
+    if (bitmap) {
+      toQueue();
+    }
+    return *std::min_element(queue_.begin(), queue_.end());
+  }
+};
+
+}  // namespace
+
+LongestPath LongestPath::of(const Grid& grid, int threads) {
+  FrontierSearch search(grid, threads);
+  LongestPath path;
+  int32_t levels;
+  path.start = search.farthest(0, levels);
+  path.goal = search.farthest(path.start, path.length);
+  return path;
+}
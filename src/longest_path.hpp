@@ -0,0 +1,67 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LONGEST_PATH_HPP
+#define LONGEST_PATH_HPP
+
+#include <cstdint>
+
+#include "grid.hpp"
+
+/**
+ * @class LongestPath
+ * @brief The longest path of a maze, found with two breadth-first searches.
+ *
+ * The cell farthest from any cell of a tree is an end of its longest path, so a
+ * search from the first cell finds one end and a search from that end finds the
+ * other. For a perfect maze the result is exact; for mazes with loops it is a
+ * lower bound.
+ *
+ * The searches are level-synchronous and switch direction per level. Small
+ * frontiers are kept as a queue and expanded top-down, on several threads once
+ * they are large enough, claiming neighbors with an atomic bit in the visited
+ * bitmap. When the frontier grows to a sizeable fraction of the cells still
+ * unvisited it is turned into a bitmap and expanded bottom-up: every unvisited
+ * cell checks whether one of its neighbors is in the frontier, and each thread
+ * only writes the bitmap words of its own cells, so no atomics are needed.
+ */
+class LongestPath {
+ public:
+  int start = 0; /**< The index of the cell at one end of the path. */
+  int goal = 0; /**< The index of the cell at the other end of the path. */
+  int32_t length = 0; /**< The number of steps from start to goal. */
+
+  /**
+   * @brief Finds the longest path of a maze.
+   *
+   * Both ends are the lowest-numbered cells at their distance, so the result does
+   * not depend on the number of threads.
+   * @param grid The maze to measure.
+   * @param threads The number of threads to use.
+   * @return The ends and the length of the longest path.
+   */
+  static LongestPath of(const Grid& grid, int threads = 1);
+};
+
+#endif  // LONGEST_PATH_HPP
@@ -25,83 +25,355 @@
 #include <iostream>
 #include <string>
 #include <chrono>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <cstdint>
+#include <vector>
 
-#include "aldous_broder.hpp"
-#include "binary_tree.cpp"
-#include "sidewinder.hpp"
-#include "wilsons.hpp"
+#include "algorithms.hpp"
+#include "batch.hpp"
+#include "ellers.hpp"
+#include "longest_path.hpp"
+#include "maze_file.hpp"
+#include "parallel.hpp"
+#include "png_writer.hpp"
+#include "random.hpp"
+#include "stats.hpp"
+#include "text_writer.hpp"
+#include "tiled.hpp"
+
+/**
+ * @brief Prints the command line usage.
+ */
+static void printUsage(const char* program) {
+  std::cout << "Usage: " << program << " [rows] [columns] [algorithm] [--seed N] [--threads N] [--tiles N] [--longest] [--stats] [--unicode] [--print-limit CELLS] [--monochrome] [--stream FILE] [--save FILE] [--load FILE] [--budget MB] [--batch MANIFEST]" << std::endl;
+  std::cout << "If no arguments are provided, the default values are used (5 5 AldousBroder)." << std::endl;
+  std::cout << "--stream writes an Ellers, Sidewinder or BinaryTree maze, or the maze given to --load, row by row to FILE without keeping it in memory." << std::endl;
+  std::cout << "A FILE ending in .png is rendered as an image, one ending in .maze is saved as a binary maze file, anything else as text." << std::endl;
+  std::cout << "--save writes the maze to a binary maze FILE that --load reads back instead of generating a maze." << std::endl;
+  std::cout << "--batch generates every maze listed in MANIFEST, one 'algorithm rows columns seed output' per line, on --threads workers." << std::endl;
+  std::cout << "--budget limits how many megabytes of a maze file are mapped into memory at once (default: all)." << std::endl;
+  std::cout << "--threads sets the number of threads used to generate BinaryTree and Sidewinder mazes and to encode images (default: all cores)." << std::endl;
+  std::cout << "--tiles generates the maze as NxN tiles in parallel, which are then joined into one maze." << std::endl;
+  std::cout << "--longest finds the longest path of the maze and marks its ends in the image." << std::endl;
+  std::cout << "--stats prints the generator's counters and phase times as one line of JSON to standard error (only counted when built with MAZES_STATS)." << std::endl;
+  std::cout << "--unicode draws text mazes with box drawing characters instead of ASCII." << std::endl;
+  std::cout << "--print-limit skips printing mazes with more cells to the console (default: 10000)." << std::endl;
+  std::cout << "--monochrome writes 1-bit grayscale images instead of RGB." << std::endl;
+  std::cerr << "Valid algorithms are: ";
+  std::vector<std::string> names = algorithmNames();
+  for (size_t i = 0; i < names.size(); i++) {
+    std::cerr << (i > 0 ? ", " : "") << names[i];
+  }
+  std::cerr << std::endl;
+}
+
+/**
+ * @brief Prints how a maze file was mapped into memory.
+ */
+static void printCounters(const char* action, const MappingCounters& counters) {
+  std::cout << action << " through " << counters.windows << " mapped windows, " << (counters.bytesMapped >> 20)
+            << " MB in total, with " << counters.minorFaults << " minor and " << counters.majorFaults
+            << " major page faults" << std::endl;
+}
+
+/**
+ * @brief Returns a string as a quoted JSON string.
+ */
+static std::string jsonString(const std::string& text) {
+  std::string json = "\"";
+  for (unsigned char c : text) {
+    if (c == '"' || c == '\\') {
+      json += '\\';
+      json += c;
+    } else if (c < 0x20) {
+      static const char hex[] = "0123456789abcdef";
+      json += "\\u00";
+      json += hex[c >> 4];
+      json += hex[c & 15];
+    } else {
+      json += c;
+    }
+  }
+  return json + "\"";
+}
+
+/**
+ * @brief Prints the counters of a run as one line of JSON to standard error, apart from the maze on standard output.
+ */
+static void printStatsJson(const std::string& algorithm, long long rows, int columns, uint64_t seed, double seconds,
+                           const Stats& stats) {
+  std::cerr << "{\"algorithm\": " << jsonString(algorithm) << ", \"rows\": " << rows << ", \"columns\": " << columns
+            << ", \"seed\": " << seed << ", \"seconds\": " << seconds << ", \"stats\": " << stats.toJson() << "}"
+            << std::endl;
+}
 
 /**
  * @brief The main function of the program.
  *
- * This function creates a grid of size rowsxcolumns and applies sidewinder algorithm to generate a maze.
- * The maze is then printed to the console and an image of the maze is generated.
+ * This function creates a grid of size rowsxcolumns and applies the chosen algorithm to generate a maze.
+ * The maze is then printed to the console and an image of the maze is generated. The same seed always
+ * produces the same maze; if none is given, a random seed is used and printed.
  *
  * @return 0 indicating successful execution of the program.
  */
 int main(int argc, char** argv) {
   // Default values for the maze
-  int rows = 5;
+  long long rows = 5;
   int columns = 5;
   int cellSize = 100;
   int wallSize = 10;
   std::string algorithm = "AldousBroder";
   std::string filename = "maze.png";
+  std::string streamFilename;
+  std::string saveFilename;
+  std::string loadFilename;
+  std::string batchFilename;
+  size_t budget = 0;
+  uint64_t seed = Random::entropy();
+  int threads = hardwareThreads();
+  bool monochrome = false;
+  bool longest = false;
+  bool printStats = false;
+  TextWriter::Style textStyle = TextWriter::ASCII;
+  long long printLimit = 10000;
+  int tileSize = 0;
+
+  // Separate options from positional arguments
+  std::vector<std::string> arguments;
+  try {
+    for (int i = 1; i < argc; i++) {
+      std::string argument = argv[i];
+      if (argument == "--seed" && i + 1 < argc) {
+        seed = std::stoull(argv[++i]);
+      } else if (argument == "--threads" && i + 1 < argc) {
+        threads = std::stoi(argv[++i]);
+      } else if (argument == "--tiles" && i + 1 < argc) {
+        tileSize = std::stoi(argv[++i]);
+      } else if (argument == "--longest") {
+        longest = true;
+      } else if (argument == "--unicode") {
+        textStyle = TextWriter::UNICODE;
+      } else if (argument == "--print-limit" && i + 1 < argc) {
+        printLimit = std::stoll(argv[++i]);
+      } else if (argument == "--stats") {
+        printStats = true;
+      } else if (argument == "--monochrome") {
+        monochrome = true;
+      } else if (argument == "--stream" && i + 1 < argc) {
+        streamFilename = argv[++i];
+      } else if (argument == "--save" && i + 1 < argc) {
+        saveFilename = argv[++i];
+      } else if (argument == "--load" && i + 1 < argc) {
+        loadFilename = argv[++i];
+      } else if (argument == "--batch" && i + 1 < argc) {
+        batchFilename = argv[++i];
+      } else if (argument == "--budget" && i + 1 < argc) {
+        budget = std::stoull(argv[++i]) << 20;
+      } else {
+        arguments.push_back(argument);
+      }
+    }
+  } catch (std::exception& e) {
+    std::cerr << "Invalid arguments. The seed, thread count, tile size, print limit and budget must be integers." << std::endl;
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  // Generate all mazes of a manifest instead of a single one
+  if (!batchFilename.empty()) {
+    std::vector<BatchJob> jobs;
+    if (!Batch::readManifest(batchFilename, jobs)) {
+      return 1;
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    int failed = Batch::run(jobs, threads, cellSize, wallSize, monochrome);
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+    std::cout << "Generated " << jobs.size() - failed << " of " << jobs.size() << " mazes in " << elapsed.count()
+              << " seconds" << std::endl;
+    return failed > 0 ? 1 : 0;
+  }
 
   // Check if arguments are provided
-  if (argc > 1) {
-    if (argc < 4) {
-      std::cout << "Usage: " << argv[0] << " [rows] [columns] [algorithm]" << std::endl;
-      std::cout << "If no arguments are provided, the default values are used (5 5 AldousBroder)." << std::endl;
-      std::cerr << "Valid algorithms are: BinaryTree, Sidewinder, AldousBroder, Wilsons" << std::endl;
+  if (!arguments.empty()) {
+    if (arguments.size() < 3) {
+      printUsage(argv[0]);
       return 1;
     }
     try {
-      rows = std::stoi(argv[1]);
-      columns = std::stoi(argv[2]);
-    } catch (std::invalid_argument& e) {
+      rows = std::stoll(arguments[0]);
+      columns = std::stoi(arguments[1]);
+    } catch (std::exception& e) {
       std::cerr << "Invalid arguments. Rows and columns must be integers." << std::endl;
-      std::cout << "Usage: " << argv[0] << " [rows] [columns] [algorithm]" << std::endl;
-      std::cout << "If no arguments are provided, the default values are used (5 5 AldousBroder)." << std::endl;
-      std::cerr << "Valid algorithms are: BinaryTree, Sidewinder, AldousBroder, Wilsons" << std::endl;
+      printUsage(argv[0]);
+      return 1;
+    }
+    if (rows <= 0 || columns <= 0) {
+      std::cerr << "Invalid arguments. Rows and columns must be positive." << std::endl;
+      printUsage(argv[0]);
       return 1;
     }
-    algorithm = argv[3];
+    algorithm = arguments[2];
   }
 
-  // Create a grid of size defined by rows and columns
-  Grid grid(rows, columns);
-  Grid output_grid(rows, columns);
+  // A saved maze brings its own size, algorithm and seed
+  std::unique_ptr<MazeFile> savedMaze;
+  if (!loadFilename.empty()) {
+    savedMaze.reset(new MazeFile(loadFilename, budget));
+    if (!savedMaze->good()) {
+      return 1;
+    }
+    rows = savedMaze->rows();
+    columns = savedMaze->columns();
+    algorithm = savedMaze->algorithm();
+    seed = savedMaze->seed();
+    std::cout << "Loaded a " << rows << "x" << columns << " " << algorithm << " maze from " << loadFilename
+              << std::endl;
+  }
+
+  Generator generator = findAlgorithm(algorithm);
+  if (!generator && !savedMaze) {
+    std::cerr << "Invalid algorithm name." << std::endl;
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  Random random(seed);
+  std::cout << "Seed: " << seed << std::endl;
+
+  // Stream the maze straight to a file without building a grid
+  if (!streamFilename.empty()) {
+    Streamer streamer = findStreamingAlgorithm(algorithm);
+    if (savedMaze) {
+      streamer = [&](int64_t, int, Random&, RowSink& sink) {
+        savedMaze->writeRows(sink);
+        return Stats();
+      };
+    } else if (!streamer) {
+      std::cerr << "Only the Ellers, Sidewinder and BinaryTree algorithms can be streamed." << std::endl;
+      return 1;
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    Stats stats;
+    bool isPng = streamFilename.size() >= 4 && streamFilename.compare(streamFilename.size() - 4, 4, ".png") == 0;
+    bool isMaze = streamFilename.size() >= 5 && streamFilename.compare(streamFilename.size() - 5, 5, ".maze") == 0;
+    if (isMaze) {
+      MazeFileWriter writer(streamFilename, rows, columns, algorithm, seed, budget);
+      if (!writer.good()) {
+        return 1;
+      }
+      stats = streamer(rows, columns, random, writer);
+      if (!writer.finish()) {
+        return 1;
+      }
+      printCounters("Written", writer.counters());
+    } else if (isPng) {
+      PngWriter writer(streamFilename, rows, columns, cellSize, wallSize, threads,
+                       monochrome ? PngWriter::MONOCHROME : PngWriter::RGB);
+      if (!writer.good()) {
+        return 1;
+      }
+      stats = streamer(rows, columns, random, writer);
+      if (!writer.finish()) {
+        return 1;
+      }
+    } else {
+      std::ofstream out(streamFilename);
+      if (!out) {
+        std::cerr << "Error opening file: " << streamFilename << std::endl;
+        return 1;
+      }
+      TextWriter writer(out, textStyle);
+      stats = streamer(rows, columns, random, writer);
+      if (!writer.finish()) {
+        std::cerr << "Error writing file: " << streamFilename << std::endl;
+        return 1;
+      }
+    }
+    if (savedMaze) {
+      printCounters("Read", savedMaze->counters());
+    }
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+    std::cout << "Maze streamed to " << streamFilename << std::endl;
+    std::cout << "Time taken: " << elapsed.count() << " seconds" << std::endl;
+    if (printStats) {
+      printStatsJson(algorithm, rows, columns, seed, elapsed.count(), stats);
+    }
+    return 0;
+  }
 
-  // BinaryTree::on(grid);
+  if (rows > std::numeric_limits<int>::max()) {
+    std::cerr << "Mazes with more rows can only be streamed." << std::endl;
+    return 1;
+  }
+
+  // Create a grid of size defined by rows and columns
+  std::optional<Grid> gridStorage;
+  try {
+    gridStorage.emplace(rows, columns);
+  } catch (std::invalid_argument& e) {
+    std::cerr << "Invalid arguments. " << e.what() << "." << std::endl;
+    printUsage(argv[0]);
+    return 1;
+  }
+  Grid& grid = *gridStorage;
 
   // Start the timer to measure the time taken to generate the maze
   auto start = std::chrono::high_resolution_clock::now();
 
   // Generate a maze using the chosen algorithm
-  if (algorithm == "BinaryTree") {
-    output_grid = BinaryTree::on(grid);
-  } else if (algorithm == "Sidewinder") {
-    output_grid = Sidewinder::on(&grid);
-  } else if (algorithm == "AldousBroder") {
-    output_grid = AldousBroder::on(&grid);
-  } else if (algorithm == "Wilsons") {
-    output_grid = Wilsons::on(&grid);
+  Stats stats;
+  if (savedMaze) {
+    GridRowSink sink(&grid);
+    savedMaze->writeRows(sink);
+  } else if (tileSize > 0) {
+    stats = Tiled::on(&grid, random, generator, tileSize, tileSize, threads);
   } else {
-    std::cerr << "Invalid algorithm name. Usage: " << argv[0] << " [algorithm] [rows] [columns]" << std::endl;
-    std::cerr << "Valid algorithms are: BinaryTree, Sidewinder, AldousBroder, Wilsons" << std::endl;
-    return 1;
+    stats = generator(&grid, random, threads);
   }
 
   // Stop the timer
   auto end = std::chrono::high_resolution_clock::now();
   std::chrono::duration<double> elapsed = end - start;
 
-  // Print the maze to the console and generate an image of the maze
-  output_grid.to_s_v1();
+  // Print the maze to the console, unless it is too large to be read there
+  if (grid.size() <= printLimit) {
+    TextWriter writer(std::cout, textStyle);
+    grid.writeRows(writer);
+    writer.finish();
+  } else {
+    std::cout << "The maze has more than " << printLimit << " cells and is not printed (see --print-limit)" << std::endl;
+  }
   std::cout << "Maze Algorithm finished successfully" << std::endl;
   std::cout << "Time taken: " << elapsed.count() << " seconds" << std::endl;
-  output_grid.generateImage(filename, cellSize, wallSize);
+
+  if (printStats) {
+    printStatsJson(algorithm, rows, columns, seed, elapsed.count(), stats);
+  }
+
+  if (!saveFilename.empty()) {
+    if (!grid.save(saveFilename, algorithm, seed)) {
+      return 1;
+    }
+    std::cout << "Maze saved to " << saveFilename << std::endl;
+  }
+
+  // Find the longest path and mark its ends in the image
+  int pathStart = -1, pathGoal = -1;
+  if (longest) {
+    LongestPath path = LongestPath::of(grid, threads);
+    pathStart = path.start;
+    pathGoal = path.goal;
+    std::cout << "Longest path: " << path.length << " steps from (" << path.start / columns << ", "
+              << path.start % columns << ") to (" << path.goal / columns << ", " << path.goal % columns << ")"
+              << std::endl;
+  }
+  if (!grid.generateImage(filename, cellSize, wallSize, threads, monochrome, pathStart, pathGoal)) {
+    return 1;
+  }
   std::cout << "Image generated successfully" << std::endl;
 
   return 0;
@@ -0,0 +1,151 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+namespace {
+
+/** The size of a memory page, which window offsets have to be a multiple of. */
+const uint64_t PAGE_BYTES = sysconf(_SC_PAGESIZE);
+
+}  // namespace
+
+MappedFile::MappedFile()
+    : descriptor_(-1), writable_(false), size_(0), budget_(0), window_(nullptr), windowStart_(0),
+      windowBytes_(0), minorFaults_(0), majorFaults_(0) {}
+
+MappedFile::~MappedFile() {
+  close();
+}
+
+bool MappedFile::open(const std::string& filename, size_t budget) {
+  close();
+  descriptor_ = ::open(filename.c_str(), O_RDONLY);
+  struct stat status;
+  if (descriptor_ < 0 || fstat(descriptor_, &status) != 0) {
+    close();
+    return false;
+  }
+  start(filename, false, status.st_size, budget);
+  return true;
+}
+
+bool MappedFile::create(const std::string& filename, uint64_t size, size_t budget) {
+  close();
+  descriptor_ = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (descriptor_ < 0 || ftruncate(descriptor_, size) != 0) {
+    close();
+    return false;
+  }
+  start(filename, true, size, budget);
+  return true;
+}
+
+void MappedFile::start(const std::string& filename, bool writable, uint64_t size, size_t budget) {
+  filename_ = filename;
+  writable_ = writable;
+  size_ = size;
+  budget_ = budget;
+  counters_ = MappingCounters();
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  minorFaults_ = usage.ru_minflt;
+  majorFaults_ = usage.ru_majflt;
+}
+
+uint8_t* MappedFile::slide(uint64_t offset, size_t bytes) {
+  if (descriptor_ < 0 || offset > size_ || bytes > size_ - offset) {
+    return nullptr;
+  }
+  if (!unmap()) {
+    return nullptr;
+  }
+
+  // Start the window at the page holding the range, and make it as large as the budget allows
+  uint64_t start = offset - offset % PAGE_BYTES;
+  uint64_t length = size_ - start;
+  if (budget_ > 0) {
+    uint64_t budget = std::max<uint64_t>(budget_ - budget_ % PAGE_BYTES, offset - start + bytes);
+    length = std::min(length, budget);
+  }
+  if (length == 0) {
+    return nullptr;
+  }
+
+  int protection = writable_ ? PROT_READ | PROT_WRITE : PROT_READ;
+  void* map = mmap(nullptr, length, protection, MAP_SHARED, descriptor_, start);
+  if (map == MAP_FAILED) {
+    return nullptr;
+  }
+  madvise(map, length, MADV_SEQUENTIAL);
+  window_ = static_cast<uint8_t*>(map);
+  windowStart_ = start;
+  windowBytes_ = length;
+  counters_.windows++;
+  counters_.bytesMapped += length;
+  return window_ + (offset - start);
+}
+
+bool MappedFile::unmap() {
+  if (!window_) {
+    return true;
+  }
+  // Start writing dirty pages back now instead of leaving them all to the end
+  bool ok = !writable_ || msync(window_, windowBytes_, MS_ASYNC) == 0;
+  ok = munmap(window_, windowBytes_) == 0 && ok;
+  window_ = nullptr;
+  windowStart_ = 0;
+  windowBytes_ = 0;
+  return ok;
+}
+
+MappingCounters MappedFile::counters() const {
+  MappingCounters counters = counters_;
+  if (descriptor_ < 0) {
+    return counters;
+  }
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  counters.minorFaults = usage.ru_minflt - minorFaults_;
+  counters.majorFaults = usage.ru_majflt - majorFaults_;
+  return counters;
+}
+
+bool MappedFile::close() {
+  bool ok = unmap();
+  if (descriptor_ >= 0) {
+    counters_ = counters();
+    ok = ::close(descriptor_) == 0 && ok;
+    descriptor_ = -1;
+  }
+  return ok;
+}
@@ -0,0 +1,132 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Counters describing how a MappedFile used memory and the disk.
+ */
+struct MappingCounters {
+  uint64_t windows = 0; /**< The number of windows mapped. */
+  uint64_t bytesMapped = 0; /**< The total size of all windows mapped. */
+  uint64_t minorFaults = 0; /**< Page faults served from the page cache while the file was open. */
+  uint64_t majorFaults = 0; /**< Page faults that had to read from disk while the file was open. */
+};
+
+/**
+ * @class MappedFile
+ * @brief A file accessed through a sliding, page-aligned memory mapping.
+ *
+ * Only a window of the file is mapped at a time. The window is as large as the
+ * resident-memory budget allows and is moved whenever a range outside of it is
+ * requested, which unmaps the old window so its pages no longer count towards
+ * the resident memory of the process. Accesses that move through the file in
+ * order, such as writing or reading a maze row by row, therefore keep at most the
+ * budget resident, however large the file is. A budget of 0 maps the whole file
+ * at once.
+ *
+ * The fault counters come from getrusage and so include faults of the whole
+ * process while the file is open.
+ */
+class MappedFile {
+ private:
+  std::string filename_; /**< The name of the file. */
+  int descriptor_; /**< The open file, or -1. */
+  bool writable_; /**< Whether the file is mapped for writing. */
+  uint64_t size_; /**< The size of the file in bytes. */
+  size_t budget_; /**< The largest window to map, or 0 for the whole file. */
+  uint8_t* window_; /**< The mapped window, or nullptr. */
+  uint64_t windowStart_; /**< The file offset of the window. */
+  size_t windowBytes_; /**< The size of the window. */
+  MappingCounters counters_; /**< The windows mapped so far. */
+  long minorFaults_; /**< The minor fault count of the process when the file was opened. */
+  long majorFaults_; /**< The major fault count of the process when the file was opened. */
+
+  /**
+   * @brief Maps a window containing the given range and returns a pointer to its first byte.
+   */
+  uint8_t* slide(uint64_t offset, size_t bytes);
+
+  void start(const std::string& filename, bool writable, uint64_t size, size_t budget);
+  bool unmap();
+
+ public:
+  MappedFile();
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /**
+   * @brief Opens an existing file for reading.
+   * @param filename The name of the file.
+   * @param budget The largest number of bytes to map at once, or 0 for the whole file.
+   * @return False if the file could not be opened.
+   */
+  bool open(const std::string& filename, size_t budget = 0);
+
+  /**
+   * @brief Creates or truncates a file of the given size for writing.
+   * @param filename The name of the file.
+   * @param size The size of the file in bytes.
+   * @param budget The largest number of bytes to map at once, or 0 for the whole file.
+   * @return False if the file could not be created.
+   */
+  bool create(const std::string& filename, uint64_t size, size_t budget = 0);
+
+  /**
+   * @brief Returns a pointer to a range of the file, valid until the next call.
+   * @param offset The offset of the first byte.
+   * @param bytes The number of bytes needed, at most the budget.
+   * @return The first byte of the range, or nullptr if the range cannot be mapped.
+   */
+  uint8_t* at(uint64_t offset, size_t bytes) {
+    if (offset >= windowStart_ && offset + bytes <= windowStart_ + windowBytes_) {
+      return window_ + (offset - windowStart_);
+    }
+    return slide(offset, bytes);
+  }
+
+  /**
+   * @brief Returns the size of the file in bytes.
+   */
+  uint64_t size() const { return size_; }
+
+  /**
+   * @brief Returns the counters of the file so far, or of its whole use once closed.
+   */
+  MappingCounters counters() const;
+
+  /**
+   * @brief Unmaps and closes the file. Returns false if unmapping failed.
+   */
+  bool close();
+};
+
+#endif  // MAPPED_FILE_HPP
@@ -0,0 +1,213 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "maze_file.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+uint32_t getUint32(const uint8_t* in) {
+  return uint32_t(in[0]) | uint32_t(in[1]) << 8 | uint32_t(in[2]) << 16 | uint32_t(in[3]) << 24;
+}
+
+uint64_t getUint64(const uint8_t* in) {
+  return uint64_t(getUint32(in)) | uint64_t(getUint32(in + 4)) << 32;
+}
+
+void putUint32(uint8_t* out, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    out[i] = value >> (8 * i);
+  }
+}
+
+void putUint64(uint8_t* out, uint64_t value) {
+  putUint32(out, value);
+  putUint32(out + 4, value >> 32);
+}
+
+/** The four passage bytes of every packed byte. */
+const std::array<std::array<uint8_t, 4>, 256> UNPACKED = [] {
+  std::array<std::array<uint8_t, 4>, 256> table = {};
+  for (int packed = 0; packed < 256; packed++) {
+    for (int cell = 0; cell < 4; cell++) {
+      table[packed][cell] = (packed >> (2 * cell)) & 3;
+    }
+  }
+  return table;
+}();
+
+}  // namespace
+
+void MazeFormat::packRow(const uint8_t* passages, int columns, uint8_t* packed) {
+  int full = columns / 4;
+  for (int i = 0; i < full; i++) {
+    const uint8_t* cells = passages + 4 * i;
+    packed[i] = (cells[0] & 3) | (cells[1] & 3) << 2 | (cells[2] & 3) << 4 | (cells[3] & 3) << 6;
+  }
+  if (columns % 4 != 0) {
+    uint8_t last = 0;
+    for (int column = 4 * full; column < columns; column++) {
+      last |= (passages[column] & 3) << (2 * (column % 4));
+    }
+    packed[full] = last;
+  }
+}
+
+void MazeFormat::unpackRow(const uint8_t* packed, int columns, uint8_t* passages) {
+  int full = columns / 4;
+  for (int i = 0; i < full; i++) {
+    std::memcpy(passages + 4 * i, UNPACKED[packed[i]].data(), 4);
+  }
+  for (int column = 4 * full; column < columns; column++) {
+    passages[column] = UNPACKED[packed[full]][column % 4];
+  }
+  // A passage out of the maze can only come from a damaged or crafted file
+  passages[columns - 1] &= ~Grid::LINK_EAST;
+}
+
+MazeFile::MazeFile(const std::string& filename, size_t budget)
+    : filename_(filename), good_(false), rows_(0), columns_(0), seed_(0), cellsOffset_(0), rowBytes_(0) {
+  if (!file_.open(filename, budget)) {
+    std::cerr << "Error opening file: " << filename << std::endl;
+    return;
+  }
+  const uint8_t* header = file_.at(0, MazeFormat::HEADER_BYTES);
+  if (!header) {
+    std::cerr << "Not a maze file: " << filename << std::endl;
+    file_.close();
+    return;
+  }
+
+  uint32_t version = getUint32(header + 8);
+  cellsOffset_ = getUint32(header + 12);
+  rows_ = getUint64(header + 16);
+  columns_ = getUint64(header + 24);
+  seed_ = getUint64(header + 32);
+  const char* name = reinterpret_cast<const char*>(header + 40);
+  algorithm_.assign(name, std::find(name, name + MazeFormat::ALGORITHM_BYTES, '\0'));
+  rowBytes_ = MazeFormat::rowBytes(columns_);
+
+  // Reject files whose rows do not fit, without overflowing on absurd dimensions
+  uint64_t size = file_.size();
+  good_ = std::equal(MazeFormat::MAGIC, MazeFormat::MAGIC + 8, header) && version == MazeFormat::VERSION &&
+          cellsOffset_ >= MazeFormat::HEADER_BYTES && cellsOffset_ <= size && rows_ > 0 && columns_ > 0 &&
+          columns_ <= uint64_t(INT32_MAX) && rows_ <= (size - cellsOffset_) / rowBytes_;
+  if (!good_) {
+    std::cerr << "Not a maze file: " << filename << std::endl;
+    file_.close();
+  }
+}
+
+void MazeFile::readRow(uint64_t row, uint8_t* passages) const {
+  MazeFormat::unpackRow(packedRow(row), columns_, passages);
+  if (row == rows_ - 1) {
+    for (uint64_t column = 0; column < columns_; column++) {
+      passages[column] &= ~Grid::LINK_SOUTH;
+    }
+  }
+}
+
+void MazeFile::writeRows(RowSink& sink) const {
+  std::vector<uint8_t> passages(columns_);
+  for (uint64_t row = 0; row < rows_; row++) {
+    readRow(row, passages.data());
+    sink.writeRow(passages.data(), columns_);
+  }
+}
+
+Grid MazeFile::load() const {
+  if (rows_ > uint64_t(INT32_MAX)) {
+    throw std::invalid_argument("Maze is too large to load: " + filename_);
+  }
+  Grid grid(rows_, columns_);
+  for (uint64_t row = 0; row < rows_; row++) {
+    readRow(row, grid.data() + grid.index(row, 0));
+  }
+  return grid;
+}
+
+MazeFileWriter::MazeFileWriter(const std::string& filename, uint64_t rows, int columns,
+                               const std::string& algorithm, uint64_t seed, size_t budget)
+    : filename_(filename), rows_(rows), columns_(columns), rowBytes_(MazeFormat::rowBytes(columns)), row_(0),
+      failed_(true) {
+  if (rows == 0 || columns <= 0 || rows > (UINT64_MAX - MazeFormat::HEADER_BYTES) / rowBytes_) {
+    std::cerr << "Invalid maze size for file: " << filename << std::endl;
+    return;
+  }
+  uint8_t* header = nullptr;
+  if (file_.create(filename, MazeFormat::HEADER_BYTES + rows * rowBytes_, budget)) {
+    header = file_.at(0, MazeFormat::HEADER_BYTES);
+  }
+  if (!header) {
+    std::cerr << "Error writing file: " << filename << std::endl;
+    file_.close();
+    return;
+  }
+
+  std::copy(MazeFormat::MAGIC, MazeFormat::MAGIC + 8, header);
+  putUint32(header + 8, MazeFormat::VERSION);
+  putUint32(header + 12, MazeFormat::HEADER_BYTES);
+  putUint64(header + 16, rows);
+  putUint64(header + 24, columns);
+  putUint64(header + 32, seed);
+  std::memset(header + 40, 0, MazeFormat::ALGORITHM_BYTES);
+  std::memcpy(header + 40, algorithm.data(), std::min(algorithm.size(), MazeFormat::ALGORITHM_BYTES));
+  failed_ = false;
+}
+
+void MazeFileWriter::writeRow(const uint8_t* passages, int columns) {
+  if (failed_ || row_ >= rows_ || columns != columns_) {
+    failed_ = true;
+    return;
+  }
+  uint8_t* packed = file_.at(MazeFormat::HEADER_BYTES + row_ * rowBytes_, rowBytes_);
+  if (!packed) {
+    std::cerr << "Error writing file: " << filename_ << std::endl;
+    failed_ = true;
+    file_.close();
+    return;
+  }
+  MazeFormat::packRow(passages, columns, packed);
+  row_++;
+  if (row_ == rows_) {
+    finish();
+  }
+}
+
+bool MazeFileWriter::finish() {
+  if (row_ != rows_ && !failed_) {
+    std::cerr << "Incomplete maze file: " << filename_ << std::endl;
+    failed_ = true;
+  }
+  if (!file_.close()) {
+    failed_ = true;
+  }
+  return !failed_;
+}
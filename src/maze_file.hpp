@@ -0,0 +1,224 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MAZE_FILE_HPP
+#define MAZE_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "grid.hpp"
+#include "mapped_file.hpp"
+#include "row_sink.hpp"
+
+/**
+ * @brief The layout of a binary maze file.
+ *
+ * A maze file starts with a 64-byte header, all numbers little-endian:
+ *
+ *   offset  size  field
+ *        0     8  magic bytes "\x8AMAZ\r\n\x1A\n"
+ *        8     4  format version, currently 1
+ *       12     4  header size in bytes
+ *       16     8  number of rows
+ *       24     8  number of columns
+ *       32     8  seed the maze was generated from
+ *       40    24  algorithm name, padded with zero bytes
+ *
+ * The header is followed by the rows from north to south. Every cell takes two
+ * bits holding its Grid::LINK_EAST and Grid::LINK_SOUTH passages, four cells to a
+ * byte with the first cell in the lowest bits, and every row starts on a byte
+ * boundary. A cell can therefore be read straight from the mapped file.
+ */
+namespace MazeFormat {
+
+constexpr uint8_t MAGIC[8] = {0x8A, 'M', 'A', 'Z', '\r', '\n', 0x1A, '\n'};
+constexpr uint32_t VERSION = 1;
+constexpr size_t HEADER_BYTES = 64;
+constexpr size_t ALGORITHM_BYTES = 24;
+
+/**
+ * @brief Returns the number of bytes of each row of a maze with the given number of columns.
+ */
+inline uint64_t rowBytes(uint64_t columns) { return (columns + 3) / 4; }
+
+/**
+ * @brief Packs one row of passage bytes into two bits per cell.
+ */
+void packRow(const uint8_t* passages, int columns, uint8_t* packed);
+
+/**
+ * @brief Unpacks one row of two-bit cells into passage bytes, dropping an east passage of the last cell.
+ */
+void unpackRow(const uint8_t* packed, int columns, uint8_t* passages);
+
+}  // namespace MazeFormat
+
+/**
+ * @class MazeFile
+ * @brief A maze file mapped into memory for reading.
+ *
+ * The file is mapped read-only, so cells are read from the page cache without
+ * parsing, and opening even a huge maze costs nothing until its rows are used.
+ * Rows can be streamed into any RowSink, for example to render a PngWriter image
+ * straight from the file, or the maze can be unpacked into a Grid.
+ *
+ * With a resident-memory budget, only a window of the file of that size is
+ * mapped at a time (see MappedFile), so streaming a maze far larger than memory
+ * keeps a bounded amount of it resident.
+ */
+class MazeFile {
+ private:
+  std::string filename_; /**< The name of the mapped file. */
+  mutable MappedFile file_; /**< The mapped file, whose window moves as rows are read. */
+  bool good_; /**< Whether the file was opened and has a valid header. */
+  uint64_t rows_; /**< The number of rows of the maze. */
+  uint64_t columns_; /**< The number of columns of the maze. */
+  uint64_t seed_; /**< The seed the maze was generated from. */
+  std::string algorithm_; /**< The name of the algorithm that generated the maze. */
+  uint64_t cellsOffset_; /**< The file offset of the first row of packed cells. */
+  uint64_t rowBytes_; /**< The number of bytes of each row. */
+
+  /**
+   * @brief Returns the packed cells of a row.
+   */
+  const uint8_t* packedRow(uint64_t row) const { return file_.at(cellsOffset_ + row * rowBytes_, rowBytes_); }
+
+ public:
+  /**
+   * @brief Maps a maze file and checks its header.
+   * @param filename The name of the file to open.
+   * @param budget The largest number of bytes of the file to map at once, or 0 for the whole file.
+   */
+  explicit MazeFile(const std::string& filename, size_t budget = 0);
+
+  MazeFile(const MazeFile&) = delete;
+  MazeFile& operator=(const MazeFile&) = delete;
+
+  /**
+   * @brief Returns false if the file could not be mapped or is not a valid maze file.
+   */
+  bool good() const { return good_; }
+
+  uint64_t rows() const { return rows_; }
+  uint64_t columns() const { return columns_; }
+  uint64_t seed() const { return seed_; }
+  const std::string& algorithm() const { return algorithm_; }
+
+  /**
+   * @brief Returns the passage bits (LINK_EAST, LINK_SOUTH) of a cell, read directly from the mapping.
+   *
+   * Passages leading out of the maze are dropped, like in readRow().
+   */
+  uint8_t passages(uint64_t row, uint64_t column) const {
+    uint8_t bits = (packedRow(row)[column / 4] >> (2 * (column % 4))) & 3;
+    if (column == columns_ - 1) bits &= ~Grid::LINK_EAST;
+    if (row == rows_ - 1) bits &= ~Grid::LINK_SOUTH;
+    return bits;
+  }
+
+  /**
+   * @brief Unpacks a row into one passage byte per cell.
+   *
+   * Passages leading out of the maze, which a damaged or crafted file may
+   * contain, are dropped, so the rows are always safe to walk.
+   * @param row The index of the row.
+   * @param passages Receives columns() bytes.
+   */
+  void readRow(uint64_t row, uint8_t* passages) const;
+
+  /**
+   * @brief Writes every row of the maze to a sink, from north to south.
+   */
+  void writeRows(RowSink& sink) const;
+
+  /**
+   * @brief Unpacks the whole maze into a Grid.
+   * @throws std::invalid_argument if the maze is too large for a Grid.
+   */
+  Grid load() const;
+
+  /**
+   * @brief Returns how many windows of the file were mapped and how many page faults occurred.
+   */
+  MappingCounters counters() const { return file_.counters(); }
+};
+
+/**
+ * @class MazeFileWriter
+ * @brief A RowSink that writes a maze file through a writable memory mapping.
+ *
+ * The file is created at its final size up front and mapped; every row is packed
+ * straight into the mapping. With a resident-memory budget only a window of the
+ * file is mapped at a time, so streaming generators can write mazes far larger
+ * than memory. Like PngWriter, the writer finishes by itself once the number of
+ * rows given to the constructor has been written.
+ */
+class MazeFileWriter : public RowSink {
+ private:
+  std::string filename_; /**< The name of the output file. */
+  MappedFile file_; /**< The mapped file, whose window moves as rows are written. */
+  uint64_t rows_; /**< The number of rows of the maze. */
+  int columns_; /**< The number of columns of the maze. */
+  uint64_t rowBytes_; /**< The number of bytes of each row. */
+  uint64_t row_; /**< The index of the next row. */
+  bool failed_; /**< Whether creating or writing the file failed. */
+
+ public:
+  /**
+   * @brief Creates a maze file for a maze of the given size.
+   * @param filename The name of the output file.
+   * @param rows The number of rows that will be written.
+   * @param columns The number of columns.
+   * @param algorithm The name of the algorithm, stored in the header. At most 24 characters are kept.
+   * @param seed The seed, stored in the header.
+   * @param budget The largest number of bytes of the file to map at once, or 0 for the whole file.
+   */
+  MazeFileWriter(const std::string& filename, uint64_t rows, int columns, const std::string& algorithm,
+                 uint64_t seed, size_t budget = 0);
+
+  MazeFileWriter(const MazeFileWriter&) = delete;
+  MazeFileWriter& operator=(const MazeFileWriter&) = delete;
+
+  /**
+   * @brief Returns false if the file could not be created or writing it failed.
+   */
+  bool good() const { return !failed_; }
+
+  void writeRow(const uint8_t* passages, int columns) override;
+
+  /**
+   * @brief Unmaps and closes the file. Returns true if every row was written successfully.
+   */
+  bool finish();
+
+  /**
+   * @brief Returns how many windows of the file were mapped and how many page faults occurred.
+   */
+  MappingCounters counters() const { return file_.counters(); }
+};
+
+#endif  // MAZE_FILE_HPP
@@ -0,0 +1,49 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <functional>
+
+/**
+ * @brief Returns the number of hardware threads, at least 1.
+ */
+int hardwareThreads();
+
+/**
+ * @brief Runs a function for every item of a range on a group of worker threads.
+ *
+ * Items are handed out one at a time from a shared counter, so uneven work is
+ * balanced automatically. The calling thread acts as worker 0, and with a single
+ * thread no threads are started at all. If a call throws, the remaining items are
+ * skipped and the first exception is rethrown once all workers have stopped.
+ *
+ * @param count The number of items; `body` is called for items 0 to count - 1.
+ * @param threads The maximum number of threads to use.
+ * @param body The function to run, called with the item and the index of the worker running it.
+ */
+void parallelFor(int count, int threads, const std::function<void(int item, int worker)>& body);
+
+#endif  // PARALLEL_HPP
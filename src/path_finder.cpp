@@ -0,0 +1,200 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "path_finder.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "parallel.hpp"
+
+PathFinder::PathFinder(const Grid& grid)
+    : grid_(&grid), nodes_(grid.size(), Node{0, 0, 0}) {
+  open_.reserve(grid.size());
+  next_.reserve(grid.size());
+}
+
+uint32_t PathFinder::nextEpoch() {
+  epoch_ += 2;
+  if (epoch_ == 0) {
+    // The stamps wrapped around, old stamps could be mistaken for new ones
+    for (Node& node : nodes_) {
+      node.stamp = 0;
+    }
+    epoch_ = 2;
+  }
+  return epoch_;
+}
+
+PathResult PathFinder::find(int start, int goal, Method method, std::vector<int>* path) {
+  return method == ASTAR ? astar(start, goal, path) : bidirectional(start, goal, path);
+}
+
+PathResult PathFinder::astar(int start, int goal, std::vector<int>* path) {
+  const uint32_t seen = nextEpoch();
+  const uint32_t closed = seen + 1;
+  const int columns = grid_->getColumns();
+  const int goalRow = goal / columns;
+  const int goalColumn = goal % columns;
+  PathResult result;
+
+  open_.clear();
+  next_.clear();
+  nodes_[start].stamp = seen;
+  nodes_[start].cost = 0;
+  nodes_[start].parent = start;
+  open_.push_back(start);
+
+  while (!open_.empty() || !next_.empty()) {
+    if (open_.empty()) {
+      std::swap(open_, next_);
+    }
+    int cell = open_.back();
+    open_.pop_back();
+    if (nodes_[cell].stamp == closed) {
+      continue;  // A duplicate entry of a cell that was later reached on a shorter path
+    }
+    nodes_[cell].stamp = closed;
+    result.expanded++;
+    if (cell == goal) {
+      result.length = nodes_[cell].cost;
+      break;
+    }
+
+    // A neighbor is closer to the goal if the step goes towards the goal's row or column
+    const int row = cell / columns;
+    const int column = cell - row * columns;
+    const int32_t cost = nodes_[cell].cost + 1;
+    grid_->eachLink(cell, [&](int neighbor) {
+      if (nodes_[neighbor].stamp == closed || (nodes_[neighbor].stamp == seen && nodes_[neighbor].cost <= cost)) {
+        return;
+      }
+      nodes_[neighbor].stamp = seen;
+      nodes_[neighbor].cost = cost;
+      nodes_[neighbor].parent = cell;
+      bool closer = neighbor == cell + 1 ? column < goalColumn
+                  : neighbor == cell - 1 ? column > goalColumn
+                  : neighbor > cell ? row < goalRow : row > goalRow;
+      (closer ? open_ : next_).push_back(neighbor);
+    });
+  }
+
+  if (path) {
+    path->clear();
+    if (result.length >= 0) {
+      for (int cell = goal; cell != start; cell = nodes_[cell].parent) {
+        path->push_back(cell);
+      }
+      path->push_back(start);
+      std::reverse(path->begin(), path->end());
+    }
+  }
+  return result;
+}
+
+PathResult PathFinder::bidirectional(int start, int goal, std::vector<int>* path) {
+  const uint32_t forward = nextEpoch();
+  const uint32_t backward = forward + 1;
+  PathResult result;
+
+  // Both frontiers are queues whose [head, tail) range holds the current level
+  open_.assign(1, start);
+  next_.assign(1, goal);
+  nodes_[start].stamp = forward;
+  nodes_[start].cost = 0;
+  nodes_[start].parent = start;
+  nodes_[goal].stamp = backward;
+  nodes_[goal].cost = 0;
+  nodes_[goal].parent = goal;
+  size_t forwardHead = 0, backwardHead = 0;
+
+  int32_t best = start == goal ? 0 : std::numeric_limits<int32_t>::max();
+  int meetForward = start, meetBackward = goal;
+
+  while (best == std::numeric_limits<int32_t>::max() && forwardHead < open_.size() &&
+         backwardHead < next_.size()) {
+    bool fromStart = open_.size() - forwardHead <= next_.size() - backwardHead;
+    std::vector<int32_t>& frontier = fromStart ? open_ : next_;
+    size_t& head = fromStart ? forwardHead : backwardHead;
+    const uint32_t mine = fromStart ? forward : backward;
+    const uint32_t theirs = fromStart ? backward : forward;
+
+    // Expand a whole level, so the shortest of all meetings in it is found
+    for (size_t end = frontier.size(); head < end; head++) {
+      int cell = frontier[head];
+      int32_t cost = nodes_[cell].cost + 1;
+      result.expanded++;
+      grid_->eachLink(cell, [&](int neighbor) {
+        if (nodes_[neighbor].stamp == theirs) {
+          if (cost + nodes_[neighbor].cost < best) {
+            best = cost + nodes_[neighbor].cost;
+            meetForward = fromStart ? cell : neighbor;
+            meetBackward = fromStart ? neighbor : cell;
+          }
+        } else if (nodes_[neighbor].stamp != mine) {
+          nodes_[neighbor].stamp = mine;
+          nodes_[neighbor].cost = cost;
+          nodes_[neighbor].parent = cell;
+          frontier.push_back(neighbor);
+        }
+      });
+    }
+  }
+
+  if (best != std::numeric_limits<int32_t>::max()) {
+    result.length = best;
+  }
+  if (path) {
+    path->clear();
+    if (result.length >= 0) {
+      for (int cell = meetForward; cell != start; cell = nodes_[cell].parent) {
+        path->push_back(cell);
+      }
+      path->push_back(start);
+      std::reverse(path->begin(), path->end());
+      if (meetBackward != meetForward) {
+        for (int cell = meetBackward; cell != goal; cell = nodes_[cell].parent) {
+          path->push_back(cell);
+        }
+        path->push_back(goal);
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<PathResult> PathFinder::findAll(const Grid& grid, const std::vector<PathQuery>& queries,
+                                            Method method, int threads) {
+  std::vector<PathResult> results(queries.size());
+  std::vector<std::unique_ptr<PathFinder>> finders(std::max(1, threads));
+  parallelFor(int(queries.size()), threads, [&](int query, int worker) {
+    if (!finders[worker]) {
+      finders[worker].reset(new PathFinder(grid));
+    }
+    results[query] = finders[worker]->find(queries[query].start, queries[query].goal, method);
+  });
+  return results;
+}
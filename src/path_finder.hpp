@@ -0,0 +1,125 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PATH_FINDER_HPP
+#define PATH_FINDER_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "grid.hpp"
+
+/**
+ * @brief A point-to-point path query between two cells given by index.
+ */
+struct PathQuery {
+  int start; /**< The index of the cell the path starts at. */
+  int goal; /**< The index of the cell the path ends at. */
+};
+
+/**
+ * @brief The answer to a PathQuery.
+ */
+struct PathResult {
+  int32_t length = -1; /**< The number of steps of a shortest path, or -1 if the goal is unreachable. */
+  int expanded = 0; /**< The number of cells whose neighbors were examined. */
+};
+
+/**
+ * @class PathFinder
+ * @brief Answers shortest-path queries between pairs of cells of a maze.
+ *
+ * All search state lives in flat per-cell arrays that are allocated once. Every
+ * query stamps the cells it touches with a new epoch, so a cell whose stamp is
+ * older simply counts as unvisited and nothing is cleared between queries.
+ *
+ * Two searches are available. A* with the Manhattan distance to the goal as
+ * heuristic: on a grid every step changes the heuristic by exactly one, so the
+ * estimated path length of a cell is either that of the cell it was reached
+ * from or two more. The open list is therefore just two stacks, one for the
+ * current estimate and one for the next. Bidirectional breadth-first search
+ * expands whole levels alternately from the start and the goal, always on the
+ * side with the smaller frontier, until the two searches meet.
+ */
+class PathFinder {
+ public:
+  enum Method { ASTAR, BIDIRECTIONAL };
+
+ private:
+  /**
+   * @brief The search state of a cell, kept together so a visit touches one cache line.
+   */
+  struct Node {
+    uint32_t stamp; /**< The epoch and state the cell was last touched with. */
+    int32_t cost; /**< Steps from the start (or the goal) to the cell. */
+    int32_t parent; /**< The cell this cell was reached from. */
+  };
+
+  const Grid* grid_; /**< The maze that is searched. */
+  uint32_t epoch_ = 0; /**< Stamp of the current query; epoch_ + 1 marks the second state. */
+  std::vector<Node> nodes_; /**< The search state of every cell. */
+  std::vector<int32_t> open_; /**< A*: cells whose estimate is the current one. Forward frontier. */
+  std::vector<int32_t> next_; /**< A*: cells whose estimate is two more. Backward frontier. */
+
+  /**
+   * @brief Starts a new query and returns its epoch.
+   */
+  uint32_t nextEpoch();
+
+  PathResult astar(int start, int goal, std::vector<int>* path);
+  PathResult bidirectional(int start, int goal, std::vector<int>* path);
+
+ public:
+  /**
+   * @brief Creates the search state for the given grid.
+   * @param grid The maze to search. It must outlive this object.
+   */
+  explicit PathFinder(const Grid& grid);
+
+  /**
+   * @brief Finds a shortest path between two cells.
+   * @param start The index of the cell the path starts at.
+   * @param goal The index of the cell the path ends at.
+   * @param method The search to use.
+   * @param path If given, receives the cell indices from start to goal, or is emptied if there is no path.
+   * @return The length of the path and the number of cells expanded.
+   */
+  PathResult find(int start, int goal, Method method = ASTAR, std::vector<int>* path = nullptr);
+
+  /**
+   * @brief Answers a batch of queries, spreading them across several threads.
+   *
+   * Every worker thread searches with its own PathFinder, so the search state is
+   * allocated once per worker rather than once per query.
+   * @param grid The maze to search.
+   * @param queries The pairs of cells to connect.
+   * @param method The search to use.
+   * @param threads The number of threads to use.
+   * @return One result per query, in the order of the queries.
+   */
+  static std::vector<PathResult> findAll(const Grid& grid, const std::vector<PathQuery>& queries,
+                                         Method method = ASTAR, int threads = 1);
+};
+
+#endif  // PATH_FINDER_HPP
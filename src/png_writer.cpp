@@ -0,0 +1,439 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "png_writer.hpp"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <csetjmp>
+#include <cstring>
+#include <iostream>
+
+#include "parallel.hpp"
+
+namespace {
+
+/** The uncompressed size a strip should have so that splitting the stream costs little compression. */
+constexpr size_t STRIP_BYTES = 1 << 20;
+
+/** PNG filter type that stores each byte as the difference to the byte above it. */
+constexpr uint8_t FILTER_UP = 2;
+
+void putUint32(uint8_t* out, uint32_t value) {
+  out[0] = value >> 24;
+  out[1] = value >> 16;
+  out[2] = value >> 8;
+  out[3] = value;
+}
+
+// Computed outside the constructor, where locals live across setjmp and might be clobbered
+int bitDepth(PngWriter::Format format) {
+  return (format == PngWriter::MONOCHROME) ? 1 : 8;
+}
+
+int colorType(PngWriter::Format format) {
+  return (format == PngWriter::MONOCHROME) ? PNG_COLOR_TYPE_GRAY : PNG_COLOR_TYPE_RGB;
+}
+
+}  // namespace
+
+PngWriter::PngWriter(const std::string& filename, int64_t rows, int columns, int cellSize, int wallSize,
+                     int threads, Format format)
+    : filename_(filename), file_(nullptr), png_(nullptr), info_(nullptr),
+      rows_(rows), columns_(columns), cellSize_(cellSize),
+      wallSize_(std::min(wallSize, cellSize)), format_(format), lineBytes_(0), row_(0), failed_(true),
+      threads_(std::max(1, threads)), stripRows_(1), groupRows_(1), pending_(0),
+      adler_(adler32(0, nullptr, 0)), zlibHeader_(true) {
+  int64_t imageWidth = int64_t(columns) * cellSize;
+  int64_t imageHeight = rows * cellSize;
+  if (imageWidth <= 0 || imageHeight <= 0 || imageWidth > PNG_UINT_31_MAX || imageHeight > PNG_UINT_31_MAX) {
+    std::cerr << "Invalid image size for file: " << filename << std::endl;
+    return;
+  }
+
+  // Error handling
+  file_ = fopen(filename.c_str(), "wb");
+  if (!file_) {
+    std::cerr << "Error opening file: " << filename << std::endl;
+    return;
+  }
+
+  lineBytes_ = (format_ == MONOCHROME) ? size_t(imageWidth + 7) / 8 : size_t(imageWidth) * 3;
+  size_t bandBytes = lineBytes_ * cellSize;
+  previous_.assign(columns, 0);
+
+  if (threads_ > 1) {
+    stripRows_ = std::max<size_t>(1, STRIP_BYTES / bandBytes);
+    groupRows_ = stripRows_ * threads_;
+    band_.resize(bandBytes * groupRows_);
+    lastLine_.assign(lineBytes_, 0);
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    uint8_t header[13] = {};
+    putUint32(header, imageWidth);
+    putUint32(header + 4, imageHeight);
+    header[8] = bitDepth(format_);
+    header[9] = colorType(format_);
+    failed_ = fwrite(signature, 1, sizeof(signature), file_) != sizeof(signature);
+    writeChunk("IHDR", header, sizeof(header));
+    if (failed_) {
+      std::cerr << "Error writing file: " << filename << std::endl;
+      close();
+    }
+    return;
+  }
+
+  png_ = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+  if (!png_) {
+    std::cerr << "Error creating PNG write struct" << std::endl;
+    close();
+    return;
+  }
+
+  info_ = png_create_info_struct(png_);
+  if (!info_) {
+    std::cerr << "Error creating PNG info struct" << std::endl;
+    close();
+    return;
+  }
+
+  if (setjmp(png_jmpbuf(png_))) {
+    std::cerr << "Error during PNG creation" << std::endl;
+    close();
+    return;
+  }
+
+  png_init_io(png_, file_);
+  png_set_IHDR(png_, info_, imageWidth, imageHeight, bitDepth(format_), colorType(format_), PNG_INTERLACE_NONE,
+               PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+  png_write_info(png_, info_);
+
+  band_.resize(bandBytes);
+  failed_ = false;
+}
+
+PngWriter::~PngWriter() {
+  close();
+}
+
+void PngWriter::close() {
+  if (png_) {
+    png_destroy_write_struct(&png_, info_ ? &info_ : nullptr);
+    png_ = nullptr;
+    info_ = nullptr;
+  }
+  if (file_) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+}
+
+void PngWriter::fillSpan(png_bytep line, int x1, int x2) {
+  x2 = std::min(x2, columns_ * cellSize_);
+  if (x1 >= x2) {
+    return;
+  }
+  if (format_ == RGB) {
+    std::memset(line + size_t(x1) * 3, 0, size_t(x2 - x1) * 3);
+    return;
+  }
+
+  // Black is a cleared bit; the leftmost pixel is the most significant bit
+  size_t first = x1 >> 3;
+  size_t last = (x2 - 1) >> 3;
+  uint8_t firstMask = 0xFF >> (x1 & 7);
+  uint8_t lastMask = 0xFF << (7 - ((x2 - 1) & 7));
+  if (first == last) {
+    line[first] &= ~(firstMask & lastMask);
+    return;
+  }
+  line[first] &= ~firstMask;
+  std::memset(line + first + 1, 0, last - first - 1);
+  line[last] &= ~lastMask;
+}
+
+void PngWriter::mark(int64_t row, int column, uint8_t red, uint8_t green, uint8_t blue) {
+  if (row < 0 || row >= rows_ || column < 0 || column >= columns_) {
+    return;
+  }
+  marks_.push_back({row, column, {red, green, blue}});
+}
+
+void PngWriter::fillMark(png_bytep band, const Mark& mark) {
+  // Leave a margin of a quarter of the open space of the cell on every side
+  int margin = (cellSize_ - wallSize_) / 4;
+  int first = wallSize_ + margin;
+  int last = std::max(first + 1, cellSize_ - margin);
+  int x1 = mark.column * cellSize_ + first;
+  int x2 = mark.column * cellSize_ + last;
+  for (int y = first; y < last && y < cellSize_; y++) {
+    png_bytep line = band + y * lineBytes_;
+    if (format_ == MONOCHROME) {
+      fillSpan(line, x1, x2);
+      continue;
+    }
+    for (int x = x1; x < x2 && x < columns_ * cellSize_; x++) {
+      std::copy(mark.color, mark.color + 3, line + size_t(x) * 3);
+    }
+  }
+}
+
+void PngWriter::rasterize(const uint8_t* passages, png_bytep band) {
+  // Every scanline starts as a copy of a white template with the vertical walls
+  png_bytep line = band;
+  std::memset(line, 0xFF, lineBytes_);
+  for (int column = 0; column < columns_; column++) {
+    int x1 = column * cellSize_;
+    bool linkedWest = column > 0 && (passages[column - 1] & Grid::LINK_EAST);
+    if (!linkedWest) {
+      fillSpan(line, x1, x1 + wallSize_);
+    }
+  }
+  // Draw east wall only if the last cell is not linked to its eastern neighbor
+  if (!(passages[columns_ - 1] & Grid::LINK_EAST)) {
+    fillSpan(line, columns_ * cellSize_ - wallSize_, columns_ * cellSize_);
+  }
+  for (int y = 1; y < cellSize_; y++) {
+    std::memcpy(band + y * lineBytes_, line, lineBytes_);
+  }
+
+  // North walls, merging runs of neighboring walls into a single span
+  for (int column = 0; column < columns_;) {
+    bool linkedNorth = row_ > 0 && (previous_[column] & Grid::LINK_SOUTH);
+    if (linkedNorth) {
+      column++;
+      continue;
+    }
+    int start = column;
+    while (column < columns_ && !(row_ > 0 && (previous_[column] & Grid::LINK_SOUTH))) {
+      column++;
+    }
+    for (int y = 0; y < wallSize_; y++) {
+      fillSpan(band + y * lineBytes_, start * cellSize_, column * cellSize_ + wallSize_);
+    }
+  }
+
+  // South walls are only drawn on the last row, merged the same way
+  if (row_ == rows_ - 1) {
+    for (int column = 0; column < columns_;) {
+      if (passages[column] & Grid::LINK_SOUTH) {
+        column++;
+        continue;
+      }
+      int start = column;
+      while (column < columns_ && !(passages[column] & Grid::LINK_SOUTH)) {
+        column++;
+      }
+      for (int y = cellSize_ - wallSize_; y < cellSize_; y++) {
+        fillSpan(band + y * lineBytes_, start * cellSize_, column * cellSize_);
+      }
+    }
+  }
+
+  for (const Mark& mark : marks_) {
+    if (mark.row == row_) {
+      fillMark(band, mark);
+    }
+  }
+}
+
+void PngWriter::writeRow(const uint8_t* passages, int columns) {
+  if (failed_ || row_ >= rows_ || columns != columns_) {
+    failed_ = true;
+    return;
+  }
+
+  size_t bandBytes = lineBytes_ * cellSize_;
+  rasterize(passages, band_.data() + pending_ * bandBytes);
+  std::copy(passages, passages + columns, previous_.begin());
+  pending_++;
+  row_++;
+
+  if (pending_ == groupRows_ || row_ == rows_) {
+    flush();
+    if (row_ == rows_) {
+      finish();
+    }
+  }
+}
+
+void PngWriter::flush() {
+  if (threads_ > 1) {
+    flushParallel();
+    pending_ = 0;
+    return;
+  }
+
+  if (setjmp(png_jmpbuf(png_))) {
+    std::cerr << "Error during PNG creation" << std::endl;
+    failed_ = true;
+    close();
+    return;
+  }
+
+  size_t stride = lineBytes_;
+  for (int y = 0; y < pending_ * cellSize_; y++) {
+    png_write_row(png_, band_.data() + y * stride);
+  }
+  pending_ = 0;
+}
+
+void PngWriter::flushParallel() {
+  size_t stride = lineBytes_;
+  size_t stripLines = size_t(stripRows_) * cellSize_;
+  size_t lines = size_t(pending_) * cellSize_;
+  int strips = (pending_ + stripRows_ - 1) / stripRows_;
+  bool lastGroup = (row_ == rows_);
+
+  std::vector<std::vector<uint8_t>> compressed(strips);
+  std::vector<uint32_t> adlers(strips);
+  std::vector<size_t> lengths(strips);
+  std::vector<uint8_t> deflated(strips, 0);
+
+  parallelFor(strips, threads_, [&](int strip, int) {
+    size_t first = strip * stripLines;
+    size_t count = std::min(stripLines, lines - first);
+
+    // Filter every scanline against the one above it, which for a maze is mostly zeros
+    std::vector<uint8_t> filtered(count * (stride + 1));
+    for (size_t line = 0; line < count; line++) {
+      const png_byte* current = band_.data() + (first + line) * stride;
+      const png_byte* above = (first + line == 0) ? lastLine_.data() : current - stride;
+      uint8_t* out = filtered.data() + line * (stride + 1);
+      out[0] = FILTER_UP;
+      for (size_t i = 0; i < stride; i++) {
+        out[i + 1] = current[i] - above[i];
+      }
+    }
+    adlers[strip] = adler32(adler32(0, nullptr, 0), filtered.data(), filtered.size());
+    lengths[strip] = filtered.size();
+
+    z_stream stream = {};
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+      return;
+    }
+    std::vector<uint8_t>& out = compressed[strip];
+    out.resize(deflateBound(&stream, filtered.size()) + 16);
+    stream.next_in = filtered.data();
+    stream.avail_in = filtered.size();
+    stream.next_out = out.data();
+    stream.avail_out = out.size();
+    int flushMode = (lastGroup && strip == strips - 1) ? Z_FINISH : Z_SYNC_FLUSH;
+    while (true) {
+      int result = deflate(&stream, flushMode);
+      if (result == Z_STREAM_ERROR) {
+        deflateEnd(&stream);
+        return;
+      }
+      bool done = (flushMode == Z_FINISH) ? result == Z_STREAM_END : (stream.avail_in == 0 && stream.avail_out > 0);
+      if (done) {
+        break;
+      }
+      size_t used = out.size() - stream.avail_out;
+      out.resize(out.size() * 2);
+      stream.next_out = out.data() + used;
+      stream.avail_out = out.size() - used;
+    }
+    out.resize(out.size() - stream.avail_out);
+    deflateEnd(&stream);
+    deflated[strip] = 1;
+  });
+
+  if (std::find(deflated.begin(), deflated.end(), 0) != deflated.end()) {
+    std::cerr << "Error compressing image: " << filename_ << std::endl;
+    failed_ = true;
+    close();
+    return;
+  }
+
+  for (int strip = 0; strip < strips; strip++) {
+    std::vector<uint8_t>& out = compressed[strip];
+    adler_ = adler32_combine(adler_, adlers[strip], lengths[strip]);
+    if (zlibHeader_) {
+      // Deflate with a 32K window and default compression
+      out.insert(out.begin(), {0x78, 0x9C});
+      zlibHeader_ = false;
+    }
+    if (lastGroup && strip == strips - 1) {
+      uint8_t checksum[4];
+      putUint32(checksum, adler_);
+      out.insert(out.end(), checksum, checksum + 4);
+    }
+    writeChunk("IDAT", out.data(), out.size());
+  }
+
+  std::copy(band_.data() + (lines - 1) * stride, band_.data() + lines * stride, lastLine_.begin());
+  if (failed_) {
+    std::cerr << "Error writing file: " << filename_ << std::endl;
+    close();
+  }
+}
+
+void PngWriter::writeChunk(const char* type, const uint8_t* data, size_t length) {
+  uint8_t header[8];
+  putUint32(header, length);
+  std::copy(type, type + 4, header + 4);
+  uint32_t crc = crc32(crc32(0, nullptr, 0), header + 4, 4);
+  if (length > 0) {
+    crc = crc32(crc, data, length);
+  }
+  uint8_t trailer[4];
+  putUint32(trailer, crc);
+  if (fwrite(header, 1, 8, file_) != 8 || fwrite(data, 1, length, file_) != length ||
+      fwrite(trailer, 1, 4, file_) != 4) {
+    failed_ = true;
+  }
+}
+
+bool PngWriter::finish() {
+  if (!file_) {
+    return !failed_;
+  }
+  if (failed_ || row_ != rows_) {
+    std::cerr << "Incomplete image: " << filename_ << std::endl;
+    failed_ = true;
+    close();
+    return false;
+  }
+
+  if (threads_ > 1) {
+    writeChunk("IEND", nullptr, 0);
+    close();
+    if (failed_) {
+      std::cerr << "Error writing file: " << filename_ << std::endl;
+    }
+    return !failed_;
+  }
+
+  if (setjmp(png_jmpbuf(png_))) {
+    std::cerr << "Error during PNG creation" << std::endl;
+    failed_ = true;
+    close();
+    return false;
+  }
+  png_write_end(png_, nullptr);
+  close();
+  return true;
+}
@@ -0,0 +1,154 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PNG_WRITER_HPP
+#define PNG_WRITER_HPP
+
+#include <png.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "row_sink.hpp"
+
+/**
+ * @class PngWriter
+ * @brief A RowSink that renders a maze into a PNG file one band at a time.
+ *
+ * Every maze row covers `cellSize` scanlines of the image. The writer rasterizes
+ * those scanlines into a single reusable band buffer and hands them to libpng
+ * with png_write_row, so memory use is proportional to the image width rather
+ * than to the whole image. The north wall of a row depends on the south passages
+ * of the row above, which is the only other state kept.
+ *
+ * Images are either 24-bit RGB or 1-bit grayscale. A band is rasterized from a
+ * single template scanline holding the vertical walls, which is copied to every
+ * scanline of the band before the horizontal walls are filled in. All walls are
+ * filled as whole spans with memset, and neighboring horizontal walls are merged
+ * into one span.
+ *
+ * With more than one thread, the writer encodes the image itself instead of
+ * through libpng: maze rows are collected into one horizontal strip per thread,
+ * each strip is filtered and deflated independently on its own thread, and the
+ * resulting raw deflate blocks are concatenated into a single zlib stream split
+ * over several IDAT chunks. Non-final strips end with a sync flush, so the output
+ * is a standard PNG any decoder can read.
+ *
+ * The image is complete once the number of rows given to the constructor has been
+ * written; finish() is then called automatically.
+ */
+class PngWriter : public RowSink {
+ public:
+  /**
+   * @brief The pixel format of the image.
+   */
+  enum Format {
+    RGB, /**< 8-bit RGB, three bytes per pixel. */
+    MONOCHROME, /**< 1-bit grayscale, eight pixels per byte; 24 times smaller than RGB. */
+  };
+
+ private:
+  /**
+   * @brief A cell whose inside is filled with a color.
+   */
+  struct Mark {
+    int64_t row;
+    int column;
+    uint8_t color[3];
+  };
+
+  std::string filename_; /**< The name of the output file. */
+  FILE* file_; /**< The output file, or nullptr once closed. */
+  png_structp png_; /**< The libpng write struct. */
+  png_infop info_; /**< The libpng info struct. */
+  int64_t rows_; /**< The number of maze rows in the image. */
+  int columns_; /**< The number of maze columns in the image. */
+  int cellSize_; /**< The size of each cell in pixels. */
+  int wallSize_; /**< The thickness of each wall in pixels. */
+  Format format_; /**< The pixel format of the image. */
+  size_t lineBytes_; /**< The number of bytes per scanline. */
+  int64_t row_; /**< The index of the next maze row. */
+  bool failed_; /**< Whether opening or writing the file failed. */
+  int threads_; /**< The number of threads used to compress the image. */
+  int stripRows_; /**< The number of maze rows per compressed strip. */
+  int groupRows_; /**< The number of maze rows buffered before they are encoded. */
+  int pending_; /**< The number of maze rows currently buffered. */
+  std::vector<png_byte> band_; /**< The scanlines of the buffered maze rows. */
+  std::vector<uint8_t> previous_; /**< The passages of the previous maze row. */
+  std::vector<png_byte> lastLine_; /**< The last scanline encoded, used by the Up filter of the next strip. */
+  uint32_t adler_; /**< The running Adler-32 checksum of the filtered image data. */
+  bool zlibHeader_; /**< Whether the zlib stream header still has to be written. */
+  std::vector<Mark> marks_; /**< The cells to fill with a color. */
+
+  void fillSpan(png_bytep line, int x1, int x2);
+  void fillMark(png_bytep band, const Mark& mark);
+  void rasterize(const uint8_t* passages, png_bytep band);
+  void flush();
+  void flushParallel();
+  void writeChunk(const char* type, const uint8_t* data, size_t length);
+  void close();
+
+ public:
+  /**
+   * @brief Opens a PNG file for a maze of the given size.
+   * @param filename The name of the output image file.
+   * @param rows The number of maze rows that will be written.
+   * @param columns The number of maze columns.
+   * @param cellSize The size of each cell in pixels.
+   * @param wallSize The thickness of each wall in pixels, at most `cellSize`.
+   * @param threads The number of threads used to compress the image.
+   * @param format The pixel format of the image.
+   */
+  PngWriter(const std::string& filename, int64_t rows, int columns, int cellSize, int wallSize = 1,
+            int threads = 1, Format format = RGB);
+
+  ~PngWriter() override;
+
+  PngWriter(const PngWriter&) = delete;
+  PngWriter& operator=(const PngWriter&) = delete;
+
+  /**
+   * @brief Returns false if the file could not be opened or writing it failed.
+   */
+  bool good() const { return !failed_; }
+
+  /**
+   * @brief Fills the inside of a cell with a color, for example to show the ends of a path.
+   *
+   * Must be called before the row of the cell is written. In monochrome images
+   * the cell is filled black.
+   */
+  void mark(int64_t row, int column, uint8_t red, uint8_t green, uint8_t blue);
+
+  void writeRow(const uint8_t* passages, int columns) override;
+
+  /**
+   * @brief Finishes the image and closes the file. Returns true if the image was written successfully.
+   */
+  bool finish();
+};
+
+#endif  // PNG_WRITER_HPP
@@ -0,0 +1,180 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "prims.hpp"
+
+#include <algorithm>
+
+namespace {
+
+constexpr int32_t UNSEEN = -1; /**< Position of a cell that is neither in the heap nor in the tree. */
+constexpr int32_t IN_TREE = -2; /**< Position of a cell that is part of the tree. */
+
+/**
+ * @brief Returns the weight of the wall east (0) or south (1) of a cell.
+ */
+uint32_t weight(uint64_t seed, int cell, int south) {
+  uint64_t z = seed + (uint64_t(2 * int64_t(cell) + south) + 1) * 0x9E3779B97F4A7C15ull;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return (z ^ (z >> 31)) >> 32;
+}
+
+/**
+ * @brief An indexed binary min-heap of cells keyed by the weight of their lightest wall to the tree.
+ */
+class CellHeap {
+ private:
+  struct Entry {
+    uint32_t key;
+    int32_t cell;
+  };
+
+  std::vector<Entry> heap_; /**< The heap, smallest key first. */
+  std::vector<int32_t> position_; /**< The heap position of every cell, or UNSEEN or IN_TREE. */
+  size_t size_ = 0; /**< The number of cells in the heap. */
+
+  void place(size_t at, Entry entry) {
+    heap_[at] = entry;
+    position_[entry.cell] = at;
+  }
+
+  void siftUp(size_t at, Entry entry) {
+    while (at > 0) {
+      size_t parent = (at - 1) / 2;
+      if (heap_[parent].key <= entry.key) {
+        break;
+      }
+      place(at, heap_[parent]);
+      at = parent;
+    }
+    place(at, entry);
+  }
+
+  void siftDown(size_t at, Entry entry) {
+    while (true) {
+      size_t child = 2 * at + 1;
+      if (child >= size_) {
+        break;
+      }
+      if (child + 1 < size_ && heap_[child + 1].key < heap_[child].key) {
+        child++;
+      }
+      if (entry.key <= heap_[child].key) {
+        break;
+      }
+      place(at, heap_[child]);
+      at = child;
+    }
+    place(at, entry);
+  }
+
+ public:
+  explicit CellHeap(size_t cells) : heap_(cells), position_(cells, UNSEEN) {}
+
+  size_t bytes() const { return heap_.size() * sizeof(Entry) + position_.size() * sizeof(int32_t); }
+
+  bool empty() const { return size_ == 0; }
+
+  int32_t position(int cell) const { return position_[cell]; }
+
+  void markInTree(int cell) { position_[cell] = IN_TREE; }
+
+  /**
+   * @brief Adds a cell, or lowers its key if it is already in the heap with a larger one.
+   * @return True if the key of the cell changed.
+   */
+  bool offer(int cell, uint32_t key) {
+    int32_t at = position_[cell];
+    if (at == UNSEEN) {
+      siftUp(size_++, {key, cell});
+      return true;
+    }
+    if (key < heap_[at].key) {
+      siftUp(at, {key, cell});
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief Removes and returns the cell with the smallest key.
+   */
+  int pop() {
+    int cell = heap_[0].cell;
+    Entry last = heap_[--size_];
+    if (size_ > 0) {
+      siftDown(0, last);
+    }
+    position_[cell] = IN_TREE;
+    return cell;
+  }
+};
+
+}  // namespace
+
+Stats Prims::on(Grid* grid, Random& random) {
+  Stats stats;
+  int columns = grid->getColumns();
+  uint64_t seed = random.next();
+  CellHeap heap(grid->size());
+  std::vector<uint8_t> via(grid->size());
+  STATS_ALLOCATION(stats, heap.bytes());
+  STATS_ALLOCATION(stats, via.size());
+
+  {
+    STATS_PHASE(stats, "carve");
+    int index = random.below(grid->size());
+    heap.markInTree(index);
+
+    while (true) {
+      // Offer the walls of the new tree cell to its neighbors outside the tree
+      int row = index / columns;
+      int column = index - row * columns;
+      uint8_t mask = grid->neighborMask(row, column);
+      for (int i = 0; i < Grid::NEIGHBOR_COUNT[mask]; i++) {
+        auto direction = static_cast<Grid::Direction>(Grid::NEIGHBOR_DIRECTIONS[mask][i]);
+        int neighbor = index + grid->offset(direction);
+        if (heap.position(neighbor) == IN_TREE) {
+          continue;
+        }
+        // Walls are named by the cell to their north or west
+        bool vertical = direction == Grid::NORTH || direction == Grid::SOUTH;
+        uint32_t key = weight(seed, std::min(index, neighbor), vertical);
+        if (heap.offer(neighbor, key)) {
+          via[neighbor] = direction ^ 1;  // NORTH <-> SOUTH, EAST <-> WEST
+        }
+      }
+
+      if (heap.empty()) {
+        break;
+      }
+      index = heap.pop();
+      grid->link(index, index + grid->offset(static_cast<Grid::Direction>(via[index])));
+      STATS_COUNT(stats, links, 1);
+    }
+  }
+
+  return stats;
+}
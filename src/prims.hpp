@@ -0,0 +1,68 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PRIMS_HPP
+#define PRIMS_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "grid.hpp"
+#include "random.hpp"
+#include "stats.hpp"
+
+/**
+ * @class Prims
+ * @brief Represents the true, weighted Prim's maze generation algorithm.
+ *
+ * Every wall between two neighboring cells gets a random weight, and the maze is
+ * the minimum spanning tree of those weights, grown by Prim's algorithm from a
+ * random cell: the cell outside the tree with the lightest wall to the tree is
+ * repeatedly joined to it. The weights are not stored; each is a hash of the seed
+ * and the wall, computed when the wall is first seen.
+ *
+ * The cells next to the tree are kept in an indexed binary heap ordered by their
+ * lightest wall to the tree. The heap stores each key next to its cell, and
+ * every cell knows its position in the heap, so a lighter wall found later
+ * moves the cell up in place instead of adding a second entry. All arrays are
+ * allocated once, sized for the grid.
+ *
+ * Unlike GrowingTree with the Selection::Random policy ("simplified Prim's"),
+ * this produces the many short dead ends of the real algorithm.
+ */
+class Prims {
+ public:
+  /**
+   * Generates a maze using Prim's algorithm on the given grid.
+   *
+   * Uses 13 bytes of memory per cell besides the grid.
+   *
+   * @param grid The grid on which the maze is generated.
+   * @param random The random number generator to draw from.
+   * @return The counters collected while generating the maze.
+   */
+  static Stats on(Grid* grid, Random& random);
+};
+
+#endif  // PRIMS_HPP
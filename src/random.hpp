@@ -0,0 +1,142 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+/**
+ * @class Random
+ * @brief A seedable xoshiro256** pseudo random number generator.
+ *
+ * Every generator draws its random numbers from a Random passed in by the caller,
+ * so a maze is fully determined by its algorithm, dimensions and seed. A seed can
+ * be split into independent streams (for example one per row or per thread), each
+ * of which is seeded from the seed and the stream id only, so results do not
+ * depend on the order in which streams are created or consumed.
+ *
+ * Random satisfies the UniformRandomBitGenerator requirements, so it can also be
+ * used with the standard library algorithms and distributions.
+ */
+class Random {
+ private:
+  uint64_t state_[4]; /**< The xoshiro256** state. */
+  uint64_t seed_; /**< The seed this generator was created from. */
+
+  static uint64_t splitMix(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+ public:
+  using result_type = uint64_t;
+
+  /**
+   * @brief Constructs a generator for a stream of the given seed.
+   * @param seed The seed.
+   * @param stream The stream id; different ids give independent sequences.
+   */
+  explicit Random(uint64_t seed, uint64_t stream = 0) : seed_(seed) {
+    uint64_t streamMix = ~stream;
+    uint64_t x = seed ^ splitMix(streamMix);
+    for (uint64_t& word : state_) {
+      word = splitMix(x);
+    }
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+  result_type operator()() { return next(); }
+
+  /**
+   * @brief Returns the next 64 random bits.
+   */
+  uint64_t next() {
+    uint64_t result = rotl(state_[1] * 5, 7) * 9;
+    uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = rotl(state_[3], 45);
+    return result;
+  }
+
+  /**
+   * @brief Returns an unbiased random number in [0, bound).
+   *
+   * Uses Lemire's multiply-and-reject method, which avoids the modulo bias and
+   * almost always avoids a division.
+   * @param bound The exclusive upper bound; must be positive.
+   */
+  uint32_t below(uint32_t bound) {
+    uint64_t product = (next() >> 32) * bound;
+    uint32_t low = static_cast<uint32_t>(product);
+    if (low < bound) {
+      uint32_t threshold = -bound % bound;
+      while (low < threshold) {
+        product = (next() >> 32) * bound;
+        low = static_cast<uint32_t>(product);
+      }
+    }
+    return static_cast<uint32_t>(product >> 32);
+  }
+
+  /**
+   * @brief Returns true or false with equal probability.
+   */
+  bool coin() { return next() >> 63; }
+
+  /**
+   * @brief Returns the seed this generator was created from.
+   */
+  uint64_t seed() const { return seed_; }
+
+  /**
+   * @brief Returns an independent generator for stream `id` of this generator's seed.
+   */
+  Random stream(uint64_t id) const { return Random(seed_, id); }
+
+  /**
+   * @brief Returns a non-deterministic seed for runs where none was given.
+   */
+  static uint64_t entropy() {
+    std::random_device device;
+    uint64_t x = (uint64_t(device()) << 32) ^ device();
+    x ^= static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    return splitMix(x);
+  }
+};
+
+#endif  // RANDOM_HPP
@@ -0,0 +1,61 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "recursive_backtracker.hpp"
+
+Stats RecursiveBacktracker::on(Grid* grid, Random& random) {
+  Stats stats;
+  int columns = grid->getColumns();
+  Bitset visited(grid->size());
+  std::vector<int32_t> stack;
+  stack.reserve(grid->size());
+  STATS_ALLOCATION(stats, visited.bytes());
+  STATS_ALLOCATION(stats, stack.capacity() * sizeof(int32_t));
+
+  {
+    STATS_PHASE(stats, "carve");
+    int start = random.below(grid->size());
+    visited.set(start);
+    stack.push_back(start);
+
+    while (!stack.empty()) {
+      int index = stack.back();
+      int row = index / columns;
+      int column = index - row * columns;
+
+      uint8_t mask = grid->neighborMask(index, row, column, visited, false);
+      if (mask == 0) {
+        stack.pop_back();
+        continue;
+      }
+      int neighbor = index + grid->offset(Grid::randomDirection(mask, random));
+      visited.set(neighbor);
+      grid->link(index, neighbor);
+      STATS_COUNT(stats, links, 1);
+      stack.push_back(neighbor);
+    }
+  }
+
+  return stats;
+}
@@ -0,0 +1,66 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef RECURSIVE_BACKTRACKER_HPP
+#define RECURSIVE_BACKTRACKER_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "bitset.hpp"
+#include "grid.hpp"
+#include "random.hpp"
+#include "stats.hpp"
+
+/**
+ * @class RecursiveBacktracker
+ * @brief Represents the recursive backtracker maze generation algorithm.
+ *
+ * The recursive backtracker is a randomized depth-first search: from the current
+ * cell it carves a passage into a random unvisited neighbor and continues from
+ * there, and when a cell has no unvisited neighbors left it backs up to the
+ * previous cell of the path. The mazes have long, winding corridors and few
+ * dead ends.
+ *
+ * Instead of recursing, the path is kept on an explicit stack of 32-bit cell
+ * indices, so the depth of the search is only limited by memory. The stack is
+ * reserved for the whole grid up front and the visited cells are kept in a
+ * bitset; the unvisited neighbors of a cell are found from the grid's neighbor
+ * mask tables, so the inner loop never allocates.
+ */
+class RecursiveBacktracker {
+ public:
+  /**
+   * Generates a maze using the recursive backtracker on the given grid.
+   *
+   * Uses at most 4 bytes of stack and 1 bit of visited set per cell besides the grid.
+   *
+   * @param grid The grid on which the maze is generated.
+   * @param random The random number generator to draw from.
+   * @return The counters collected while generating the maze.
+   */
+  static Stats on(Grid* grid, Random& random);
+};
+
+#endif  // RECURSIVE_BACKTRACKER_HPP
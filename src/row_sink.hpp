@@ -0,0 +1,71 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ROW_SINK_HPP
+#define ROW_SINK_HPP
+
+#include <cstdint>
+#include <cstring>
+
+#include "grid.hpp"
+
+/**
+ * @class RowSink
+ * @brief Receives a maze one row at a time, from north to south.
+ *
+ * Rows use the same passage bits as Grid (LINK_EAST, LINK_SOUTH), one byte per
+ * cell. Streaming generators such as Ellers write into a sink instead of a Grid,
+ * so the consumer decides whether the maze is kept in memory, rendered or written
+ * to disk, and memory use stays proportional to the width of the maze.
+ */
+class RowSink {
+ public:
+  virtual ~RowSink() = default;
+
+  /**
+   * @brief Receives the next row of the maze.
+   * @param passages The passage bits of each cell in the row. Only valid for the duration of the call.
+   * @param columns The number of cells in the row.
+   */
+  virtual void writeRow(const uint8_t* passages, int columns) = 0;
+};
+
+/**
+ * @class GridRowSink
+ * @brief A RowSink that stores the rows it receives in a Grid.
+ */
+class GridRowSink : public RowSink {
+ private:
+  Grid* grid_; /**< The grid receiving the rows. */
+  int row_; /**< The index of the next row to fill. */
+
+ public:
+  explicit GridRowSink(Grid* grid) : grid_(grid), row_(0) {}
+
+  void writeRow(const uint8_t* passages, int columns) override {
+    std::memcpy(grid_->data() + grid_->index(row_++, 0), passages, columns);
+  }
+};
+
+#endif  // ROW_SINK_HPP
@@ -24,31 +24,75 @@
 
 #include "sidewinder.hpp"
 
-Grid Sidewinder::on(Grid *grid) {
-  srand((unsigned int)time(NULL));
-  (*grid).eachRow([&](std::vector<Cell*>& row) {
-    std::vector<Cell*> run;
-
-    for (Cell* cell : row) {
-      run.push_back(cell);
-
-      bool at_eastern_boundary = (cell->east_ == nullptr);
-      bool at_northern_boundary = (cell->north_ == nullptr);
-
-      bool should_close_out =
-        at_eastern_boundary ||
-        (!at_northern_boundary && rand() % 2 == 0);
-
-      if (should_close_out) {
-        Cell* member = run[rand() % run.size()];
-        if (member->north_ != nullptr) {
-          member->link(member->north_);
-        }
-        run.clear();
-      } else {
-        cell->link(cell->east_);
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+Stats Sidewinder::on(Grid *grid, Random& random, int threads) {
+  Stats stats;
+  uint64_t seed = random.next();
+  int columns = grid->getColumns();
+
+  {
+    STATS_PHASE(stats, "rows");
+    std::mutex statsMutex;
+    grid->eachRowInParallel(threads, [&](int row) {
+      uint8_t* current = grid->data() + grid->index(row, 0);
+      Stats rowStats;
+      carveRow(seed, row, current, row > 0 ? current - columns : nullptr, columns, rowStats);
+      if (Stats::ENABLED) {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.merge(rowStats);
+      }
+    });
+  }
+  return stats;
+}
+
+Stats Sidewinder::stream(int64_t rows, int columns, Random& random, RowSink& sink) {
+  Stats stats;
+  uint64_t seed = random.next();
+  std::vector<uint8_t> above(columns), current(columns);
+  STATS_ALLOCATION(stats, above.size());
+  STATS_ALLOCATION(stats, current.size());
+
+  for (int64_t row = 0; row < rows; row++) {
+    std::fill(current.begin(), current.end(), 0);
+    carveRow(seed, row, current.data(), row > 0 ? above.data() : nullptr, columns, stats);
+    if (row > 0) {
+      sink.writeRow(above.data(), columns);
+    }
+    std::swap(above, current);
+  }
+  if (rows > 0) {
+    sink.writeRow(above.data(), columns);
+  }
+  return stats;
+}
+
+void Sidewinder::carveRow(uint64_t seed, int64_t row, uint8_t* current, uint8_t* above, int columns,
+                          [[maybe_unused]] Stats& stats) {
+  Random rowRandom(seed, row);
+  int runStart = 0;
+
+  for (int column = 0; column < columns; column++) {
+    bool at_eastern_boundary = (column == columns - 1);
+    bool at_northern_boundary = (above == nullptr);
+
+    bool should_close_out =
+      at_eastern_boundary ||
+      (!at_northern_boundary && rowRandom.coin());
+
+    if (should_close_out) {
+      int member = runStart + rowRandom.below(column - runStart + 1);
+      if (!at_northern_boundary) {
+        above[member] |= Grid::LINK_SOUTH;
+        STATS_COUNT(stats, links, 1);
       }
+      runStart = column + 1;
+    } else {
+      current[column] |= Grid::LINK_EAST;
+      STATS_COUNT(stats, links, 1);
     }
-  });
-return *grid;
+  }
 }
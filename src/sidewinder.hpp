@@ -25,9 +25,13 @@
 #ifndef SIDEWINDER_HPP
 #define SIDEWINDER_HPP
 
+#include <cstdint>
 #include <vector>
 
 #include "grid.hpp"
+#include "random.hpp"
+#include "row_sink.hpp"
+#include "stats.hpp"
 
 /**
  * @class Sidewinder
@@ -41,8 +45,11 @@
  * northern neighbor. This process continues until all cells have been visited.
  *
  * The Sidewinder class provides a static method `on` that takes a Grid object as input
- * and generates a maze using the Sidewinder algorithm. The generated maze is returned as
- * a Grid object.
+ * and generates a maze using the Sidewinder algorithm in place.
+ *
+ * Runs never span rows and every row draws from its own random stream, so rows can be
+ * generated on several threads. The maze only depends on the seed, not on the number
+ * of threads.
  */
 class Sidewinder {
  public:
@@ -50,9 +57,39 @@ class Sidewinder {
    * Generates a maze using the Sidewinder algorithm on the given grid.
    *
    * @param grid The grid on which the maze is generated.
-   * @return The grid with the generated maze.
+   * @param random The random number generator to draw from.
+   * @param threads The number of threads to use.
+   * @return The counters collected while generating the maze.
+   */
+  static Stats on(Grid *grid, Random& random, int threads = 1);
+
+  /**
+   * Generates a maze using the Sidewinder algorithm and writes it to a sink row by row.
+   *
+   * A row is passed on once the row below it has carved its north passages, so
+   * only two rows are kept in memory. The maze is the same as the one `on`
+   * generates from the same seed.
+   *
+   * @param rows The number of rows of the maze.
+   * @param columns The number of columns of the maze.
+   * @param random The random number generator to draw from.
+   * @param sink The sink receiving each finished row.
+   * @return The counters collected while generating the maze.
+   */
+  static Stats stream(int64_t rows, int columns, Random& random, RowSink& sink);
+
+ private:
+  /**
+   * Carves the passages of a single row.
+   *
+   * @param seed The seed of the maze; every row draws from its own stream of it.
+   * @param row The index of the row.
+   * @param current The passage bits of the row, which receive its east passages.
+   * @param above The passage bits of the row above, which receive the north passages, or nullptr for the first row.
+   * @param columns The number of columns.
+   * @param stats The stats counting the passages carved.
    */
-  static Grid on(Grid *grid);
+  static void carveRow(uint64_t seed, int64_t row, uint8_t* current, uint8_t* above, int columns, Stats& stats);
 };
 
 #endif // SIDEWINDER_HPP
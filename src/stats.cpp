@@ -0,0 +1,62 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "stats.hpp"
+
+#include <cstring>
+#include <sstream>
+
+void Stats::addPhase(const char* name, double seconds) {
+  for (auto& phase : phases) {
+    if (std::strcmp(phase.first, name) == 0) {
+      phase.second += seconds;
+      return;
+    }
+  }
+  phases.emplace_back(name, seconds);
+}
+
+void Stats::merge(const Stats& other) {
+  steps += other.steps;
+  revisits += other.revisits;
+  erasures += other.erasures;
+  links += other.links;
+  allocations += other.allocations;
+  allocatedBytes += other.allocatedBytes;
+  for (const auto& phase : other.phases) {
+    addPhase(phase.first, phase.second);
+  }
+}
+
+std::string Stats::toJson() const {
+  std::ostringstream json;
+  json << "{\"enabled\": " << (ENABLED ? "true" : "false") << ", \"steps\": " << steps
+       << ", \"revisits\": " << revisits << ", \"erasures\": " << erasures << ", \"links\": " << links
+       << ", \"allocations\": " << allocations << ", \"allocated_bytes\": " << allocatedBytes << ", \"phases\": {";
+  for (size_t i = 0; i < phases.size(); i++) {
+    json << (i > 0 ? ", " : "") << "\"" << phases[i].first << "\": " << phases[i].second;
+  }
+  json << "}}";
+  return json.str();
+}
@@ -0,0 +1,113 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef STATS_HPP
+#define STATS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct Stats
+ * @brief Counters collected while a maze is generated.
+ *
+ * The counters are only updated when the library is built with MAZES_STATS
+ * (the CMake option of the same name). Otherwise the STATS_ macros below expand
+ * to nothing, the hot loops are exactly the same as without instrumentation and
+ * every counter stays zero.
+ */
+struct Stats {
+  uint64_t steps = 0; /**< Random walk steps. */
+  uint64_t revisits = 0; /**< Random walk steps onto a cell that was already part of the maze. */
+  uint64_t erasures = 0; /**< Random walk steps thrown away because they were part of an erased loop. */
+  uint64_t links = 0; /**< Passages carved. */
+  uint64_t allocations = 0; /**< Scratch buffers allocated by the generator. */
+  uint64_t allocatedBytes = 0; /**< Total size of those buffers. */
+  std::vector<std::pair<const char*, double>> phases; /**< Seconds spent in each phase, in the order they started. */
+
+#ifdef MAZES_STATS
+  static constexpr bool ENABLED = true;
+#else
+  static constexpr bool ENABLED = false;
+#endif
+
+  /**
+   * @brief Adds time to a phase, appending the phase if it is new.
+   */
+  void addPhase(const char* name, double seconds);
+
+  /**
+   * @brief Adds the counters and phase times of another run, e.g. of another tile or worker.
+   */
+  void merge(const Stats& other);
+
+  /**
+   * @brief Returns the counters as a JSON object.
+   */
+  std::string toJson() const;
+};
+
+/**
+ * @class PhaseTimer
+ * @brief Adds the time between its construction and destruction to a phase of a Stats.
+ */
+class PhaseTimer {
+ private:
+  Stats& stats_; /**< The stats receiving the time. */
+  const char* name_; /**< The name of the phase. */
+  std::chrono::steady_clock::time_point start_; /**< When the phase started. */
+
+ public:
+  PhaseTimer(Stats& stats, const char* name)
+      : stats_(stats), name_(name), start_(std::chrono::steady_clock::now()) {}
+
+  ~PhaseTimer() {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+    stats_.addPhase(name_, elapsed.count());
+  }
+
+  PhaseTimer(const PhaseTimer&) = delete;
+  PhaseTimer& operator=(const PhaseTimer&) = delete;
+};
+
+#define STATS_CONCAT_(a, b) a##b
+#define STATS_CONCAT(a, b) STATS_CONCAT_(a, b)
+
+#ifdef MAZES_STATS
+/** Adds an amount to one of the counters of a Stats. */
+#define STATS_COUNT(stats, counter, amount) ((stats).counter += (amount))
+/** Records a scratch buffer of the given size. */
+#define STATS_ALLOCATION(stats, bytes) ((stats).allocations++, (stats).allocatedBytes += (bytes))
+/** Times the rest of the enclosing scope as a phase. */
+#define STATS_PHASE(stats, name) PhaseTimer STATS_CONCAT(phaseTimer, __LINE__)(stats, name)
+#else
+#define STATS_COUNT(stats, counter, amount) ((void)0)
+#define STATS_ALLOCATION(stats, bytes) ((void)0)
+#define STATS_PHASE(stats, name) ((void)0)
+#endif
+
+#endif  // STATS_HPP
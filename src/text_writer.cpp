@@ -0,0 +1,148 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "text_writer.hpp"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <string>
+
+namespace {
+
+constexpr int UP = 1, DOWN = 2, LEFT = 4, RIGHT = 8;
+
+/** The box drawing character joining the lines in each combination of UP, DOWN, LEFT and RIGHT. */
+const char* const JUNCTIONS[16] = {
+  " ", "╵", "╷", "│", "╴", "┘", "┐", "┤",
+  "╶", "└", "┌", "├", "─", "┴", "┬", "┼",
+};
+
+const std::string ASCII_OPEN = "    ", ASCII_WALL = "   |";
+const std::string UNICODE_OPEN = "    ", UNICODE_WALL = "   │";
+const std::string UNICODE_LINE = "───", UNICODE_GAP = "   ";
+
+}  // namespace
+
+TextWriter::TextWriter(std::ostream& out, Style style)
+    : out_(&out), fd_(-1), style_(style), started_(false), finished_(false), failed_(false) {
+  buffer_.reserve(BUFFER_BYTES + (BUFFER_BYTES >> 2));
+}
+
+TextWriter::TextWriter(int fd, Style style)
+    : out_(nullptr), fd_(fd), style_(style), started_(false), finished_(false), failed_(false) {
+  buffer_.reserve(BUFFER_BYTES + (BUFFER_BYTES >> 2));
+}
+
+TextWriter::~TextWriter() {
+  finish();
+}
+
+void TextWriter::writeBorder(const uint8_t* above, const uint8_t* below, int columns) {
+  if (style_ == ASCII) {
+    buffer_.push_back('+');
+    for (int column = 0; column < columns; column++) {
+      bool open = above && below && (above[column] & Grid::LINK_SOUTH);
+      buffer_.append(open ? "   +" : "---+");
+    }
+    buffer_.push_back('\n');
+    return;
+  }
+
+  // A corner joins the walls east of the cells to its left and the walls south
+  // of the cells above it. The outer walls are always closed.
+  for (int column = 0; column <= columns; column++) {
+    bool outside = column == 0 || column == columns;
+    int junction = 0;
+    if (above && (outside || !(above[column - 1] & Grid::LINK_EAST))) junction |= UP;
+    if (below && (outside || !(below[column - 1] & Grid::LINK_EAST))) junction |= DOWN;
+    if (column > 0 && !(above && below && (above[column - 1] & Grid::LINK_SOUTH))) junction |= LEFT;
+    if (column < columns && !(above && below && (above[column] & Grid::LINK_SOUTH))) junction |= RIGHT;
+    buffer_.append(JUNCTIONS[junction]);
+    if (column < columns) {
+      buffer_.append((junction & RIGHT) ? UNICODE_LINE : UNICODE_GAP);
+    }
+  }
+  buffer_.push_back('\n');
+}
+
+void TextWriter::writeBody(const uint8_t* passages, int columns) {
+  const std::string& open = style_ == ASCII ? ASCII_OPEN : UNICODE_OPEN;
+  const std::string& wall = style_ == ASCII ? ASCII_WALL : UNICODE_WALL;
+  buffer_.append(style_ == ASCII ? "|" : "│");
+  for (int column = 0; column < columns; column++) {
+    buffer_.append((passages[column] & Grid::LINK_EAST) ? open : wall);
+  }
+  buffer_.push_back('\n');
+}
+
+void TextWriter::flush() {
+  if (failed_) {
+    buffer_.clear();
+    return;
+  }
+  if (out_) {
+    failed_ = !out_->write(buffer_.data(), buffer_.size());
+  } else {
+    const char* data = buffer_.data();
+    size_t remaining = buffer_.size();
+    while (remaining > 0) {
+      ssize_t written = ::write(fd_, data, remaining);
+      if (written < 0 && errno == EINTR) {
+        continue;
+      }
+      if (written <= 0) {
+        failed_ = true;
+        break;
+      }
+      data += written;
+      remaining -= written;
+    }
+  }
+  buffer_.clear();
+}
+
+void TextWriter::writeRow(const uint8_t* passages, int columns) {
+  writeBorder(started_ ? previous_.data() : nullptr, passages, columns);
+  writeBody(passages, columns);
+  previous_.assign(passages, passages + columns);
+  started_ = true;
+  if (buffer_.size() > BUFFER_BYTES) {
+    flush();
+  }
+}
+
+bool TextWriter::finish() {
+  if (!finished_) {
+    if (started_) {
+      writeBorder(previous_.data(), nullptr, previous_.size());
+    }
+    flush();
+    if (out_ && !failed_) {
+      failed_ = !out_->flush();
+    }
+    finished_ = true;
+  }
+  return !failed_;
+}
@@ -0,0 +1,96 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TEXT_WRITER_HPP
+#define TEXT_WRITER_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "row_sink.hpp"
+
+/**
+ * @class TextWriter
+ * @brief A RowSink that draws a maze as text to an output stream or file descriptor.
+ *
+ * The drawing is built row by row in a reused line buffer, which is handed to
+ * the output whenever it holds more than BUFFER_BYTES, so arbitrarily large
+ * mazes are written with a handful of large writes and without allocating per
+ * row. The border between two rows is only drawn once the row below it arrives,
+ * because the Unicode corners depend on the walls of both rows; the bottom
+ * border is drawn by finish().
+ */
+class TextWriter : public RowSink {
+ public:
+  /**
+   * @brief The characters the maze is drawn with.
+   */
+  enum Style {
+    ASCII, /**< `+`, `-` and `|`, four characters per cell. */
+    UNICODE, /**< UTF-8 box drawing characters with proper corners and junctions. */
+  };
+
+  static constexpr size_t BUFFER_BYTES = 1 << 16; /**< The buffer size above which the buffer is written out. */
+
+ private:
+  std::ostream* out_; /**< The stream receiving the drawing, or nullptr to write to fd_. */
+  int fd_; /**< The file descriptor receiving the drawing if there is no stream. */
+  Style style_; /**< The characters the maze is drawn with. */
+  std::string buffer_; /**< The lines not written out yet, reused for the whole maze. */
+  std::vector<uint8_t> previous_; /**< The passages of the previous row. */
+  bool started_; /**< Whether a row has been written. */
+  bool finished_; /**< Whether the bottom border has been written. */
+  bool failed_; /**< Whether writing to the output failed. */
+
+  void writeBorder(const uint8_t* above, const uint8_t* below, int columns);
+  void writeBody(const uint8_t* passages, int columns);
+  void flush();
+
+ public:
+  /**
+   * @brief Draws to an output stream.
+   */
+  explicit TextWriter(std::ostream& out, Style style = ASCII);
+
+  /**
+   * @brief Draws to a file descriptor, bypassing the stream library. The descriptor is not closed.
+   */
+  explicit TextWriter(int fd, Style style = ASCII);
+
+  ~TextWriter() override;
+
+  TextWriter(const TextWriter&) = delete;
+  TextWriter& operator=(const TextWriter&) = delete;
+
+  void writeRow(const uint8_t* passages, int columns) override;
+
+  /**
+   * @brief Draws the bottom border and writes out the buffer. Returns true if everything was written.
+   */
+  bool finish();
+};
+
+#endif  // TEXT_WRITER_HPP
@@ -0,0 +1,100 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tiled.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "parallel.hpp"
+#include "wilsons.hpp"
+
+Stats Tiled::on(Grid* grid, Random& random, const Generator& generator, int tileRows, int tileColumns,
+               int threads) {
+  int rows = grid->getRows();
+  int columns = grid->getColumns();
+  tileRows = std::max(1, std::min(tileRows, rows));
+  tileColumns = std::max(1, std::min(tileColumns, columns));
+  int tilesDown = (rows + tileRows - 1) / tileRows;
+  int tilesAcross = (columns + tileColumns - 1) / tileColumns;
+  uint64_t seed = random.next();
+
+  // Generate every tile into a tile-sized grid and copy it into place. Tiles
+  // never share a cell, so the copies do not overlap. Every worker reuses one
+  // grid for all of its tiles and collects the counters of its own tiles, so
+  // the phase times add up the time of all workers.
+  int workers = std::max(1, std::min(threads, tilesDown * tilesAcross));
+  std::vector<Grid> parts;
+  std::vector<Stats> workerStats(workers);
+  for (int worker = 0; worker < workers; worker++) {
+    parts.emplace_back(tileRows, tileColumns);
+    STATS_ALLOCATION(workerStats[worker], parts.back().size());
+  }
+  parallelFor(tilesDown * tilesAcross, workers, [&](int tile, int worker) {
+    int row = (tile / tilesAcross) * tileRows;
+    int column = (tile % tilesAcross) * tileColumns;
+    Grid& part = parts[worker];
+    part.reset(std::min(tileRows, rows - row), std::min(tileColumns, columns - column));
+    Random tileRandom(seed, tile);
+    workerStats[worker].merge(generator(&part, tileRandom, 1));
+    grid->place(part, row, column);
+  });
+  Stats stats;
+  for (const Stats& worker : workerStats) {
+    stats.merge(worker);
+  }
+
+  // Join the tiles along a uniform spanning tree of the tile graph
+  {
+    STATS_PHASE(stats, "seams");
+    Grid tiles(tilesDown, tilesAcross);
+    Random seamRandom(seed, tilesDown * int64_t(tilesAcross));
+    Wilsons::on(&tiles, seamRandom);
+
+    for (int tileRow = 0; tileRow < tilesDown; tileRow++) {
+      for (int tileColumn = 0; tileColumn < tilesAcross; tileColumn++) {
+        uint8_t seams = tiles.passages(tiles.index(tileRow, tileColumn));
+        int top = tileRow * tileRows;
+        int left = tileColumn * tileColumns;
+        int height = std::min(tileRows, rows - top);
+        int width = std::min(tileColumns, columns - left);
+
+        if (seams & Grid::LINK_EAST) {
+          int row = top + seamRandom.below(height);
+          int cell = grid->index(row, left + width - 1);
+          grid->link(cell, cell + 1);
+          STATS_COUNT(stats, links, 1);
+        }
+        if (seams & Grid::LINK_SOUTH) {
+          int column = left + seamRandom.below(width);
+          int cell = grid->index(top + height - 1, column);
+          grid->link(cell, cell + columns);
+          STATS_COUNT(stats, links, 1);
+        }
+      }
+    }
+  }
+
+  return stats;
+}
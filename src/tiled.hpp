@@ -0,0 +1,64 @@
+/*
+ * MIT License
+ *
+ * Copyright (C) 2024 juloem
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TILED_HPP
+#define TILED_HPP
+
+#include "algorithms.hpp"
+#include "grid.hpp"
+#include "random.hpp"
+
+/**
+ * @class Tiled
+ * @brief Generates huge mazes by running another algorithm on rectangular tiles in parallel.
+ *
+ * The grid is partitioned into tiles of equal size (the last row and column of
+ * tiles may be smaller). Each tile is generated independently on its own worker
+ * thread into a tile-sized Grid, with its own random stream, and then copied into
+ * place. Because every tile holds a perfect maze, the tiles only need to be joined
+ * along a spanning tree of the tile graph: Wilson's algorithm picks a uniform
+ * spanning tree over a grid of tiles, and every edge of that tree becomes a single
+ * passage at a random position along the seam between the two tiles. The result
+ * is a perfect maze whose texture inside each tile is that of the chosen algorithm.
+ */
+class Tiled {
+ public:
+  /**
+   * Generates a maze on the given grid by running an algorithm on each tile.
+   *
+   * The maze only depends on the seed and the tile size, not on the number of threads.
+   *
+   * @param grid The grid on which the maze is generated.
+   * @param random The random number generator to draw from.
+   * @param generator The algorithm run on each tile. It is called with a single thread.
+   * @param tileRows The number of rows of each tile.
+   * @param tileColumns The number of columns of each tile.
+   * @param threads The number of tiles generated at the same time.
+   * @return The counters collected while generating the maze, summed over all tiles.
+   */
+  static Stats on(Grid* grid, Random& random, const Generator& generator, int tileRows, int tileColumns,
+                  int threads = 1);
+};
+
+#endif  // TILED_HPP
@@ -24,36 +24,50 @@
 
 #include "wilsons.hpp"
 
-Grid Wilsons::on(Grid* grid) {
-    srand((unsigned int)time(NULL));
-    std::vector<Cell*> unvisited;
-    grid->eachCell([&](Cell* cell) {
-      unvisited.push_back(cell);
-    });
-
-    Cell* first = unvisited[rand() % unvisited.size()];
-    unvisited.erase(std::remove(unvisited.begin(), unvisited.end(), first), unvisited.end());
+Stats Wilsons::on(Grid* grid, Random& random) {
+    Bitset visited(grid->size());
+    visited.set(random.below(grid->size()));
+    Stats stats = complete(grid, visited, random);
+    STATS_ALLOCATION(stats, visited.bytes());
+    return stats;
+}
 
-    while (!unvisited.empty()) {
-      Cell* cell = unvisited[rand() % unvisited.size()];
-      std::vector<Cell*> path;
-      path.push_back(cell);
+Stats Wilsons::complete(Grid* grid, Bitset& visited, Random& random) {
+    Stats stats;
+    {
+      STATS_PHASE(stats, "wilsons");
+      int columns = grid->getColumns();
+      std::vector<uint8_t> exits(grid->size());
+      STATS_ALLOCATION(stats, exits.size());
 
-      while (std::find(unvisited.begin(), unvisited.end(), cell) != unvisited.end()) {
-        cell = cell->getNeighbors()[rand() % cell->getNeighbors().size()];
-        auto it = std::find(path.begin(), path.end(), cell);
-        if (it != path.end()) {
-          path.erase(it + 1, path.end());
-        } else {
-          path.push_back(cell);
+      for (size_t start = visited.findNextZero(0); start < visited.size();
+           start = visited.findNextZero(start + 1)) {
+        // Random walk until the maze is hit, overwriting the exit of revisited cells.
+        // A later exit replaces an earlier one, which erases the loop in between.
+        int row = start / columns;
+        int column = start % columns;
+        int index = start;
+        while (!visited.test(index)) {
+          Grid::Direction direction = grid->randomDirection(row, column, random);
+          exits[index] = direction;
+          STATS_COUNT(stats, steps, 1);
+          row += Grid::ROW_STEP[direction];
+          column += Grid::COLUMN_STEP[direction];
+          index = grid->index(row, column);
         }
-      }
 
-      for (int i = 0; i < path.size() - 1; i++) {
-        path[i]->link(path[i + 1]);
-        unvisited.erase(std::remove(unvisited.begin(), unvisited.end(), path[i]), unvisited.end());
+        // Follow the recorded exits from the start to carve the loop-erased path.
+        index = start;
+        while (!visited.test(index)) {
+          visited.set(index);
+          int next = index + grid->offset(static_cast<Grid::Direction>(exits[index]));
+          grid->link(index, next);
+          STATS_COUNT(stats, links, 1);
+          index = next;
+        }
       }
     }
-
-    return *grid;
+    // Every step of a walk that was not carved was erased with a loop
+    STATS_COUNT(stats, erasures, stats.steps - stats.links);
+    return stats;
 }
@@ -27,7 +27,10 @@
 
 #include <vector>
 
+#include "bitset.hpp"
 #include "grid.hpp"
+#include "random.hpp"
+#include "stats.hpp"
 
 /**
  * @class Wilsons
@@ -46,9 +49,26 @@ class Wilsons {
    * Generates a Wilson's maze on the given grid.
    *
    * @param grid The grid on which the maze is generated.
-   * @return The grid with the generated maze.
+   * @param random The random number generator to draw from.
+   * @return The counters collected while generating the maze.
    */
-  static Grid on(Grid* grid);
+  static Stats on(Grid* grid, Random& random);
+
+  /**
+   * Completes a maze by running loop-erased random walks from every unvisited cell.
+   *
+   * The visited cells must already form a tree in the grid (for example a single
+   * cell). Each walk stores only the direction it last left every cell in, so
+   * following those directions from the start of the walk yields the loop-erased
+   * path without ever searching it. The walks visit the unvisited cells in index
+   * order, which does not affect uniformity of the resulting spanning tree.
+   *
+   * @param grid The grid on which the maze is completed.
+   * @param visited One bit per cell, set for cells already in the maze. All bits are set on return.
+   * @param random The random number generator to draw from.
+   * @return The counters collected while completing the maze.
+   */
+  static Stats complete(Grid* grid, Bitset& visited, Random& random);
 };
 
 #endif  // WILSONS_HPP
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/algorithms.hpp"
+#include "../src/batch.hpp"
+#include "../src/grid.hpp"
+#include "../src/maze_file.hpp"
+#include "../src/random.hpp"
+
+int main() {
+  // A reset grid generates the same maze as a new one
+  Grid reused(40, 50);
+  Random first(1), second(2);
+  findAlgorithm("Wilsons")(&reused, first, 1);
+  reused.reset(7, 9);
+  first = Random(2);
+  findAlgorithm("Wilsons")(&reused, first, 1);
+  Grid fresh(7, 9);
+  findAlgorithm("Wilsons")(&fresh, second, 1);
+  assert(reused.getRows() == 7 && reused.getColumns() == 9);
+  assert(std::equal(fresh.data(), fresh.data() + fresh.size(), reused.data()));
+
+  // Invalid lines are rejected, comments and empty lines skipped
+  std::vector<BatchJob> jobs;
+  std::istringstream invalid("# comment\n\nWilsons 3 4 5\nNoSuchAlgorithm 3 4 5 a.maze\nEllers 0 4 5 a.maze\n");
+  assert(!Batch::readManifest(invalid, jobs));
+  assert(jobs.empty());
+
+  // Every job writes the maze of its own seed, whatever the number of workers
+  std::istringstream manifest(
+    "# algorithm rows columns seed output\n"
+    "Wilsons 12 9 7 gt_batch_0.maze\n"
+    "Sidewinder 3 30 8 gt_batch_1.maze\n"
+    "AldousBroder 20 20 9 gt_batch_2.maze\n"
+    "Ellers 5 5 10 gt_batch_3.maze\n");
+  assert(Batch::readManifest(manifest, jobs));
+  assert(jobs.size() == 4);
+  assert(Batch::run(jobs, 3, 4, 1, false) == 0);
+  for (const BatchJob& job : jobs) {
+    Grid expected(job.rows, job.columns);
+    Random random(job.seed);
+    findAlgorithm(job.algorithm)(&expected, random, 1);
+    MazeFile file(job.output);
+    assert(file.good() && file.seed() == job.seed && file.algorithm() == job.algorithm);
+    Grid loaded = file.load();
+    assert(std::equal(expected.data(), expected.data() + expected.size(), loaded.data()));
+    std::remove(job.output.c_str());
+  }
+
+  return 0;
+}
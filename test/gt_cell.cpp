@@ -1,38 +1,88 @@
 #include <cassert>
-#include "../src/cell.cpp"
+#include <sstream>
+#include <type_traits>
+#include <utility>
+#include "../src/grid.hpp"
+#include "../src/text_writer.hpp"
 
 int main() {
   // Create cells
-  Cell cell1(0, 0);
-  Cell cell2(1, 0);
-  Cell cell3(0, 1);
+  Grid grid(2, 2);
+  Cell cell1 = grid.getCell(0, 0);
+  Cell cell2 = grid.getCell(1, 0);
+  Cell cell3 = grid.getCell(0, 1);
+  Cell cell4 = grid.getCell(1, 1);
+
+  // Out of bounds positions are null cells
+  assert(!grid.getCell(-1, 0));
+  assert(!grid.getCell(0, 2));
+  assert(!cell1.north());
+  assert(!cell1.west());
 
   // Link cells
-  cell1.link(&cell2);
-  cell1.link(&cell3);
+  cell1.link(cell2);
+  cell1.link(cell3);
+
+  // Check if cells are linked, links are always bidirectional
+  assert(cell1.isLinked(cell2));
+  assert(cell2.isLinked(cell1));
+  assert(cell1.isLinked(cell3));
+  assert(!cell2.isLinked(cell3));
+  assert(!cell1.isLinked(cell4));
+  assert(!cell1.isLinked(Cell()));
 
-  // Check if cells are linked
-  assert(cell1.isLinked(&cell2));
-  assert(cell1.isLinked(&cell3));
-  assert(!cell2.isLinked(&cell3));
+  // Passages are stored as east/south bits on the north-western cell
+  assert(grid.passages(grid.index(0, 0)) == (Grid::LINK_EAST | Grid::LINK_SOUTH));
+  assert(grid.passages(grid.index(1, 0)) == 0);
 
   // Get linked cells
-  std::vector<Cell*> linkedCells = cell1.getLinks();
+  std::vector<Cell> linkedCells = cell1.getLinks();
   assert(linkedCells.size() == 2);
-  assert(linkedCells[0] == &cell2);
-  assert(linkedCells[1] == &cell3);
+  assert(linkedCells[0] == cell2);
+  assert(linkedCells[1] == cell3);
 
-  // Get neighboring cells
-  std::vector<Cell*> neighbors = cell1.getNeighbors();
-  assert(neighbors.size() == 0);
+  // Unlink cells
+  cell2.unlink(cell1);
+  assert(!cell1.isLinked(cell2));
+  assert(cell1.getLinks().size() == 1);
 
-  cell1.north_ = &cell2;
-  cell1.south_ = &cell3;
+  // Get neighboring cells
+  std::vector<Cell> neighbors = cell1.getNeighbors();
+  assert(neighbors.size() == 2);
+  assert(neighbors[0] == cell2);
+  assert(neighbors[1] == cell3);
 
-  neighbors = cell1.getNeighbors();
+  neighbors = cell4.getNeighbors();
   assert(neighbors.size() == 2);
-  assert(neighbors[0] == &cell2);
-  assert(neighbors[1] == &cell3);
+  assert(neighbors[0] == cell3);
+  assert(neighbors[1] == cell2);
+
+  // A single column grid only has vertical neighbors
+  Grid column(3, 1);
+  column.getCell(0, 0).link(column.getCell(1, 0));
+  assert(column.passages(0) == Grid::LINK_SOUTH);
+  assert(column.getCell(1, 0).isLinked(column.getCell(0, 0)));
+
+  // Text drawings in ASCII and with box drawing characters
+  Grid small(2, 2);
+  small.link(0, 1);
+  small.link(1, 3);
+  small.link(2, 3);
+  assert(small.to_s_v1() == "+---+---+\n|       |\n+---+   +\n|       |\n+---+---+\n");
+  std::ostringstream unicode;
+  TextWriter writer(unicode, TextWriter::UNICODE);
+  small.writeRows(writer);
+  assert(writer.finish());
+  assert(unicode.str() == "┌───────┐\n│       │\n├───╴   │\n│       │\n└───────┘\n");
+
+  // Grids are moved, never copied, and a moved-from grid is empty
+  static_assert(!std::is_copy_constructible<Grid>::value, "grids must not be copied");
+  Grid moved(std::move(column));
+  assert(moved.size() == 3 && moved.passages(0) == Grid::LINK_SOUTH);
+  assert(column.size() == 0);
+  column = std::move(moved);
+  assert(column.size() == 3 && column.isLinked(1, 0));
+  assert(moved.size() == 0);
 
   return 0;
-}
\ No newline at end of file
+}
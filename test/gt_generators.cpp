@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include "../src/aldous_broder.hpp"
+#include "../src/algorithms.hpp"
+#include "../src/binary_tree.cpp"
+#include "../src/ellers.hpp"
+#include "../src/growing_tree.hpp"
+#include "../src/hunt_and_kill.hpp"
+#include "../src/kruskals.hpp"
+#include "../src/prims.hpp"
+#include "../src/recursive_backtracker.hpp"
+#include "../src/row_sink.hpp"
+#include "../src/sidewinder.hpp"
+#include "../src/tiled.hpp"
+#include "../src/wilsons.hpp"
+
+// A perfect maze is a spanning tree: every cell is reachable and there are
+// exactly size() - 1 passages.
+bool isPerfect(Grid& grid) {
+  int links = 0;
+  for (int i = 0; i < grid.size(); i++) {
+    uint8_t passages = grid.passages(i);
+    links += ((passages & Grid::LINK_EAST) != 0) + ((passages & Grid::LINK_SOUTH) != 0);
+  }
+  if (links != grid.size() - 1) {
+    return false;
+  }
+
+  std::vector<bool> reached(grid.size(), false);
+  std::vector<Cell> stack = {grid.getCell(0, 0)};
+  reached[0] = true;
+  int count = 1;
+  while (!stack.empty()) {
+    Cell cell = stack.back();
+    stack.pop_back();
+    for (Cell neighbor : cell.getLinks()) {
+      if (!reached[neighbor.index()]) {
+        reached[neighbor.index()] = true;
+        count++;
+        stack.push_back(neighbor);
+      }
+    }
+  }
+  return count == grid.size();
+}
+
+bool sameMaze(const Grid& a, const Grid& b) {
+  return a.size() == b.size() && std::equal(a.data(), a.data() + a.size(), b.data());
+}
+
+int main() {
+  const int sizes[][2] = {{1, 1}, {1, 7}, {7, 1}, {2, 2}, {13, 17}, {64, 64}};
+  Random random(42);
+
+  for (auto& size : sizes) {
+    Grid binaryTree(size[0], size[1]);
+    BinaryTree::on(&binaryTree, random);
+    assert(isPerfect(binaryTree));
+
+    Grid sidewinder(size[0], size[1]);
+    Sidewinder::on(&sidewinder, random);
+    assert(isPerfect(sidewinder));
+
+    Grid ellers(size[0], size[1]);
+    Ellers::on(&ellers, random);
+    assert(isPerfect(ellers));
+
+    Grid aldousBroder(size[0], size[1]);
+    AldousBroder::on(&aldousBroder, random);
+    assert(isPerfect(aldousBroder));
+
+    Grid hybrid(size[0], size[1]);
+    AldousBroder::on(&hybrid, random, AldousBroder::HYBRID_HANDOFF);
+    assert(isPerfect(hybrid));
+
+    Grid wilsons(size[0], size[1]);
+    Wilsons::on(&wilsons, random);
+    assert(isPerfect(wilsons));
+
+    Grid kruskals(size[0], size[1]);
+    Kruskals::on(&kruskals, random);
+    assert(isPerfect(kruskals));
+
+    Grid backtracker(size[0], size[1]);
+    RecursiveBacktracker::on(&backtracker, random);
+    assert(isPerfect(backtracker));
+
+    Grid huntAndKill(size[0], size[1]);
+    HuntAndKill::on(&huntAndKill, random);
+    assert(isPerfect(huntAndKill));
+
+    Grid newest(size[0], size[1]), oldest(size[0], size[1]), uniform(size[0], size[1]), mixed(size[0], size[1]);
+    GrowingTree<Selection::Newest>::on(&newest, random);
+    GrowingTree<Selection::Oldest>::on(&oldest, random);
+    GrowingTree<Selection::Random>::on(&uniform, random);
+    GrowingTree<Selection::Mixed<30>>::on(&mixed, random);
+    assert(isPerfect(newest) && isPerfect(oldest) && isPerfect(uniform) && isPerfect(mixed));
+
+    Grid prims(size[0], size[1]);
+    Prims::on(&prims, random);
+    assert(isPerfect(prims));
+  }
+
+  // Removing active cells keeps the newest one at the tail for the Newest and Mixed policies
+  ActiveCells active(8);
+  for (int cell = 0; cell < 6; cell++) active.push(cell);
+  active.remove(3);
+  assert(active[active.tail() - 1] == 5);
+  active.remove(active.head());
+  active.remove(active.tail() - 1);
+  assert(active[active.tail() - 1] == 4);
+  active.push(6);
+  active.remove(active.head() + 1);
+  assert(active[active.tail() - 1] == 6 && active.tail() - active.head() == 3);
+  std::vector<int> remaining;
+  for (size_t position = active.head(); position < active.tail(); position++) remaining.push_back(active[position]);
+  std::sort(remaining.begin(), remaining.end());
+  assert((remaining == std::vector<int>{2, 4, 6}));
+
+  // The same seed always produces the same maze
+  Grid first(32, 32), second(32, 32), third(32, 32);
+  Random firstRandom(7), secondRandom(7), thirdRandom(8);
+  Wilsons::on(&first, firstRandom);
+  Wilsons::on(&second, secondRandom);
+  Wilsons::on(&third, thirdRandom);
+  assert(sameMaze(first, second));
+  assert(!sameMaze(first, third));
+
+  // Row-parallel generators give the same maze for any number of threads
+  Grid serialBinaryTree(33, 70), parallelBinaryTree(33, 70);
+  BinaryTree::on(&serialBinaryTree, firstRandom = Random(9));
+  BinaryTree::on(&parallelBinaryTree, secondRandom = Random(9), 4);
+  assert(sameMaze(serialBinaryTree, parallelBinaryTree));
+  assert(isPerfect(parallelBinaryTree));
+
+  Grid serialSidewinder(33, 70), parallelSidewinder(33, 70);
+  Sidewinder::on(&serialSidewinder, firstRandom = Random(9));
+  Stats parallelSidewinderStats = Sidewinder::on(&parallelSidewinder, secondRandom = Random(9), 4);
+  assert(parallelSidewinderStats.links == (Stats::ENABLED ? uint64_t(parallelSidewinder.size() - 1) : 0));
+  assert(sameMaze(serialSidewinder, parallelSidewinder));
+  assert(isPerfect(parallelSidewinder));
+
+  // Tiles of any algorithm are joined into one perfect maze, independent of the thread count
+  for (const std::string& name : algorithmNames()) {
+    Grid serialTiled(45, 61), parallelTiled(45, 61);
+    Tiled::on(&serialTiled, firstRandom = Random(3), findAlgorithm(name), 8, 16);
+    Tiled::on(&parallelTiled, secondRandom = Random(3), findAlgorithm(name), 8, 16, 3);
+    assert(isPerfect(serialTiled));
+    assert(sameMaze(serialTiled, parallelTiled));
+  }
+
+  // Generators count one link per passage and, for random walks, every step, when stats are enabled
+  for (const std::string& name : algorithmNames()) {
+    Grid grid(30, 40);
+    Stats stats = findAlgorithm(name)(&grid, firstRandom = Random(8), 1);
+    assert(stats.links == (Stats::ENABLED ? uint64_t(grid.size() - 1) : 0));
+    assert(stats.steps == stats.revisits + stats.erasures + (stats.steps > 0 ? stats.links : 0));
+  }
+
+  // Streaming generators write the same maze row by row
+  Grid streamedBinaryTree(21, 34), streamedSidewinder(21, 34);
+  GridRowSink binaryTreeSink(&streamedBinaryTree), sidewinderSink(&streamedSidewinder);
+  Stats binaryTreeStats = BinaryTree::stream(21, 34, firstRandom = Random(6), binaryTreeSink);
+  Stats sidewinderStats = Sidewinder::stream(21, 34, secondRandom = Random(6), sidewinderSink);
+  assert(binaryTreeStats.links == (Stats::ENABLED ? uint64_t(21 * 34 - 1) : 0));
+  assert(sidewinderStats.links == binaryTreeStats.links);
+  assert(binaryTreeStats.allocations == (Stats::ENABLED ? 2 : 0));
+  Grid binaryTree(21, 34);
+  BinaryTree::on(&binaryTree, firstRandom = Random(6));
+  assert(sameMaze(streamedBinaryTree, binaryTree));
+  Grid sidewinder(21, 34);
+  Sidewinder::on(&sidewinder, secondRandom = Random(6));
+  assert(sameMaze(streamedSidewinder, sidewinder));
+
+  // Streams of a seed are independent of each other and of creation order
+  Random streamOne = Random(7).stream(1);
+  Random streamTwo = Random(7).stream(2);
+  assert(streamOne.next() != streamTwo.next());
+  assert(Random(7).stream(1).next() == Random(7, 1).next());
+
+  return 0;
+}
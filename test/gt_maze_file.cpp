@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../src/grid.hpp"
+#include "../src/maze_file.hpp"
+#include "../src/random.hpp"
+#include "../src/wilsons.hpp"
+
+int main() {
+  const std::string filename = "gt_maze_file.maze";
+  Random random(5);
+
+  // Mazes survive a round trip through a file, whatever the number of columns
+  const int sizes[][2] = {{1, 1}, {3, 5}, {13, 17}, {9, 64}};
+  for (auto& size : sizes) {
+    Grid grid(size[0], size[1]);
+    Wilsons::on(&grid, random);
+    assert(grid.save(filename, "Wilsons", 1234));
+
+    MazeFile file(filename);
+    assert(file.good());
+    assert(file.rows() == uint64_t(size[0]));
+    assert(file.columns() == uint64_t(size[1]));
+    assert(file.seed() == 1234);
+    assert(file.algorithm() == "Wilsons");
+    for (int row = 0; row < grid.getRows(); row++) {
+      for (int column = 0; column < grid.getColumns(); column++) {
+        assert(file.passages(row, column) == grid.passages(grid.index(row, column)));
+      }
+    }
+    Grid loaded = file.load();
+    assert(std::equal(grid.data(), grid.data() + grid.size(), loaded.data()));
+  }
+
+  // Two bits per cell, with every row starting on a byte boundary
+  Grid wide(3, 5);
+  assert(wide.save(filename));
+  std::ifstream in(filename, std::ios::binary | std::ios::ate);
+  assert(in.tellg() == std::streampos(MazeFormat::HEADER_BYTES + 3 * 2));
+  in.close();
+
+  // Files that are cut short or are not maze files are rejected
+  std::vector<char> bytes(MazeFormat::HEADER_BYTES + 5);
+  std::ifstream(filename, std::ios::binary).read(bytes.data(), bytes.size());
+  std::ofstream(filename, std::ios::binary).write(bytes.data(), bytes.size());
+  assert(!MazeFile(filename).good());
+  std::ofstream(filename, std::ios::binary) << "not a maze at all, but long enough to hold a header......";
+  assert(!MazeFile(filename).good());
+  assert(!MazeFile("does-not-exist.maze").good());
+
+  // With a small budget the file is mapped a window at a time, with the same result
+  Grid tall(200, 1000);
+  Wilsons::on(&tall, random);
+  MazeFileWriter windowed(filename, tall.getRows(), tall.getColumns(), "Wilsons", 0, 8192);
+  tall.writeRows(windowed);
+  assert(windowed.finish());
+  assert(windowed.counters().windows > 1);
+  MazeFile windowedFile(filename, 8192);
+  assert(windowedFile.good());
+  Grid reloaded = windowedFile.load();
+  assert(std::equal(tall.data(), tall.data() + tall.size(), reloaded.data()));
+  assert(windowedFile.passages(0, 999) == tall.passages(999));
+  assert(windowedFile.counters().windows > 1);
+
+  // Passages leading out of the maze in a crafted file are dropped
+  Grid small(3, 5);
+  assert(small.save(filename));
+  std::vector<char> crafted(MazeFormat::HEADER_BYTES + 3 * 2);
+  std::ifstream(filename, std::ios::binary).read(crafted.data(), crafted.size());
+  std::fill(crafted.begin() + MazeFormat::HEADER_BYTES, crafted.end(), char(0xFF));
+  std::ofstream(filename, std::ios::binary).write(crafted.data(), crafted.size());
+  MazeFile craftedFile(filename);
+  assert(craftedFile.good());
+  assert(craftedFile.passages(0, 4) == Grid::LINK_SOUTH);
+  assert(craftedFile.passages(2, 0) == Grid::LINK_EAST);
+  assert(craftedFile.passages(2, 4) == 0);
+  Grid open = craftedFile.load();
+  for (int i = 0; i < open.size(); i++) {
+    open.eachLink(i, [&](int neighbor) { assert(neighbor >= 0 && neighbor < open.size()); });
+  }
+  assert(open.passages(open.index(1, 4)) == Grid::LINK_SOUTH);
+  assert(open.passages(open.index(2, 3)) == Grid::LINK_EAST);
+
+  // A writer that does not receive every row reports failure
+  MazeFileWriter writer(filename, 2, 4, "Test", 0);
+  std::vector<uint8_t> row(4, Grid::LINK_EAST);
+  writer.writeRow(row.data(), 4);
+  assert(!writer.finish());
+
+  std::remove(filename.c_str());
+  return 0;
+}
@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <vector>
+
+#include "../src/distance_oracle.hpp"
+#include "../src/distances.hpp"
+#include "../src/grid.hpp"
+#include "../src/longest_path.hpp"
+#include "../src/path_finder.hpp"
+#include "../src/random.hpp"
+#include "../src/wilsons.hpp"
+
+// Distances computed the slow way, following the links of every Cell
+std::vector<int> referenceDistances(Grid& grid, int source) {
+  std::vector<int> distance(grid.size(), Distances::UNREACHED);
+  std::vector<Cell> frontier = {grid.getCell(source / grid.getColumns(), source % grid.getColumns())};
+  distance[source] = 0;
+  for (int step = 1; !frontier.empty(); step++) {
+    std::vector<Cell> next;
+    for (Cell cell : frontier) {
+      for (Cell neighbor : cell.getLinks()) {
+        if (distance[neighbor.index()] == Distances::UNREACHED) {
+          distance[neighbor.index()] = step;
+          next.push_back(neighbor);
+        }
+      }
+    }
+    frontier = next;
+  }
+  return distance;
+}
+
+// A path is valid if it starts at a source, ends at the target and every step follows a passage
+bool isPath(const Grid& grid, const std::vector<int>& path, int source, int target) {
+  if (path.empty() || path.front() != source || path.back() != target) {
+    return false;
+  }
+  for (size_t i = 1; i < path.size(); i++) {
+    int a = path[i - 1], b = path[i];
+    bool adjacent = b == a + 1 || b == a - 1 || b == a + grid.getColumns() || b == a - grid.getColumns();
+    if (!adjacent || !grid.isLinked(a, b)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  Random random(11);
+
+  // Distances match a search over the Cell links, on mazes of every shape
+  const int sizes[][2] = {{1, 1}, {1, 9}, {9, 1}, {20, 31}};
+  for (auto& size : sizes) {
+    Grid grid(size[0], size[1]);
+    Wilsons::on(&grid, random);
+    Distances distances(grid);
+    int source = grid.size() / 2;
+    distances.from(source);
+    std::vector<int> expected = referenceDistances(grid, source);
+    for (int cell = 0; cell < grid.size(); cell++) {
+      assert(distances[cell] == expected[cell]);
+    }
+    assert(distances.reached() == grid.size());
+    assert(distances[distances.farthest()] == distances.maximum());
+
+    std::vector<int> path;
+    assert(distances.pathTo(distances.farthest(), path));
+    assert(int(path.size()) == distances.maximum() + 1);
+    assert(isPath(grid, path, source, distances.farthest()));
+  }
+
+  // A corridor measured from both ends meets in the middle
+  Grid corridor(1, 9);
+  for (int cell = 0; cell < 8; cell++) {
+    corridor.link(cell, cell + 1);
+  }
+  Distances distances(corridor);
+  distances.from(std::vector<int>{0, 8});
+  assert(distances[4] == 4);
+  assert(distances[7] == 1);
+  assert(distances.maximum() == 4);
+
+  // Cells without passages are unreached, and the buffers are reused for another grid
+  Grid walls(3, 3);
+  walls.link(0, 1);
+  distances.reset(walls);
+  distances.from(0);
+  assert(distances[1] == 1);
+  assert(distances[3] == Distances::UNREACHED);
+  assert(distances.reached() == 2);
+  std::vector<int> path = {1, 2, 3};
+  assert(!distances.pathTo(8, path));
+  assert(path.empty());
+
+  // Both searches find shortest paths, on a maze and on an open field with many shortest paths
+  Grid maze(23, 29);
+  Wilsons::on(&maze, random);
+  Grid field(23, 29);
+  for (int cell = 0; cell < field.size(); cell++) {
+    if (cell % 29 < 28) field.link(cell, cell + 1);
+    if (cell + 29 < field.size()) field.link(cell, cell + 29);
+  }
+  std::vector<PathQuery> queries;
+  for (int i = 0; i < 200; i++) {
+    queries.push_back({int(random.below(maze.size())), int(random.below(maze.size()))});
+  }
+  for (Grid* grid : {&maze, &field}) {
+    PathFinder finder(*grid);
+    Distances measured(*grid);
+    for (PathQuery query : queries) {
+      measured.from(query.start);
+      for (PathFinder::Method method : {PathFinder::ASTAR, PathFinder::BIDIRECTIONAL}) {
+        PathResult result = finder.find(query.start, query.goal, method, &path);
+        assert(result.length == measured[query.goal]);
+        assert(int(path.size()) == result.length + 1);
+        assert(isPath(*grid, path, query.start, query.goal));
+      }
+    }
+
+    // A* walks straight to the goal when nothing is in the way
+    if (grid == &field) {
+      PathResult result = finder.find(0, field.size() - 1);
+      assert(result.expanded == result.length + 1);
+    }
+
+    // Batches give the same answers on any number of threads
+    std::vector<PathResult> serial = PathFinder::findAll(*grid, queries, PathFinder::BIDIRECTIONAL);
+    std::vector<PathResult> parallel = PathFinder::findAll(*grid, queries, PathFinder::BIDIRECTIONAL, 3);
+    for (size_t i = 0; i < queries.size(); i++) {
+      assert(serial[i].length == parallel[i].length);
+      assert(serial[i].expanded == parallel[i].expanded);
+    }
+  }
+
+  // Unreachable goals are reported as such
+  PathFinder finder(walls);
+  assert(finder.find(0, 8, PathFinder::ASTAR, &path).length == -1);
+  assert(path.empty());
+  assert(finder.find(0, 8, PathFinder::BIDIRECTIONAL).length == -1);
+  assert(finder.find(1, 0, PathFinder::BIDIRECTIONAL).length == 1);
+
+  // The oracle agrees with a search on every query and finds the cell halfway along each path
+  for (auto& size : sizes) {
+    Grid grid(size[0], size[1]);
+    Wilsons::on(&grid, random);
+    DistanceOracle oracle(grid);
+    Distances measured(grid);
+    assert(oracle.memoryBytes() >= grid.size() * 6 * sizeof(int32_t));
+    for (int i = 0; i < 20; i++) {
+      int a = random.below(grid.size());
+      measured.from(a);
+      for (int b = 0; b < grid.size(); b++) {
+        int32_t length = oracle.distance(a, b);
+        assert(length == measured[b]);
+        int middle = oracle.midpoint(a, b);
+        assert(oracle.distance(a, middle) == length / 2);
+        assert(oracle.distance(middle, b) == length - length / 2);
+      }
+    }
+  }
+
+  // Mazes with loops or unreachable cells are rejected
+  bool rejected = false;
+  try {
+    DistanceOracle oracle(field);
+  } catch (std::invalid_argument&) {
+    rejected = true;
+  }
+  assert(rejected);
+
+  // The longest path matches the largest distance between any two cells
+  for (auto& size : sizes) {
+    Grid grid(size[0], size[1]);
+    Wilsons::on(&grid, random);
+    Distances measured(grid);
+    int32_t longest = 0;
+    for (int cell = 0; cell < grid.size(); cell++) {
+      measured.from(cell);
+      longest = std::max(longest, measured.maximum());
+    }
+    LongestPath path = LongestPath::of(grid, 2);
+    assert(path.length == longest);
+    measured.from(path.start);
+    assert(measured[path.goal] == longest);
+  }
+  assert(LongestPath::of(field).length == 23 + 29 - 2);
+
+  return 0;
+}